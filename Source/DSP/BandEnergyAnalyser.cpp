@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    BandEnergyAnalyser Implementation
+  ==============================================================================
+*/
+
+#include "BandEnergyAnalyser.h"
+#include "Parameters.h"
+
+namespace Aetheri
+{
+    namespace
+    {
+        // The analysis keeps the audible band; higher rates are averaged down to this
+        constexpr double targetAnalysisRate = 44100.0;
+
+        // Returned to the analysis thread as the wait until the next slice (ms)
+        constexpr int idleWaitMs = 20;
+    }
+
+    /** One low-priority analysis thread shared by every plugin instance */
+    struct BandEnergyAnalyser::AnalysisThread : public juce::TimeSliceThread
+    {
+        AnalysisThread() : juce::TimeSliceThread("Aetheri Band Analysis")
+        {
+            startThread(juce::Thread::Priority::low);
+        }
+
+        ~AnalysisThread() override
+        {
+            stopThread(1000);
+        }
+    };
+
+    BandEnergyAnalyser::BandEnergyAnalyser()
+    {
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), fftSize,
+                                                                 juce::dsp::WindowingFunction<float>::hann, false);
+
+        for (int ch = 0; ch < NumChannels; ++ch)
+        {
+            for (int band = 0; band < NumBands; ++band)
+            {
+                centres[ch][band].store(BandDefaults::getDefaultFreq(band));
+                energies[ch][band].store(0.0f);
+                bandWeights[ch][band].assign(fftSize / 2 + 1, 0.0f);
+            }
+        }
+
+        prepare(targetAnalysisRate);
+    }
+
+    BandEnergyAnalyser::~BandEnergyAnalyser()
+    {
+        analysisThread->removeTimeSliceClient(this);
+    }
+
+    void BandEnergyAnalyser::prepare(double sampleRate)
+    {
+        const juce::ScopedLock sl(analysisLock);
+
+        decimation = std::max(1, static_cast<int>(sampleRate / targetAnalysisRate));
+        decimationCount = 0;
+        decimationSum.fill(0.0f);
+        analysisRate = sampleRate / decimation;
+
+        fifo.reset();
+        frameFill = 0;
+
+        // Scales the one-sided windowed power so a sine reads its RMS level
+        double windowPower = 0.0;
+        for (auto w : window)
+            windowPower += static_cast<double>(w) * w;
+        powerScale = static_cast<float>(2.0 / (fftSize * windowPower));
+
+        // Bin frequencies moved - force the band weights to be rebuilt
+        for (auto& channel : weightedCentres)
+            channel.fill(0.0f);
+
+        for (auto& channel : energies)
+            for (auto& energy : channel)
+                energy.store(0.0f);
+    }
+
+    void BandEnergyAnalyser::setEnabled(bool shouldBeEnabled)
+    {
+        if (enabled.exchange(shouldBeEnabled) == shouldBeEnabled)
+            return;
+
+        if (shouldBeEnabled)
+        {
+            analysisThread->addTimeSliceClient(this);
+        }
+        else
+        {
+            // Blocks until any slice in progress has finished
+            analysisThread->removeTimeSliceClient(this);
+
+            for (auto& channel : energies)
+                for (auto& energy : channel)
+                    energy.store(0.0f);
+        }
+    }
+
+    void BandEnergyAnalyser::setBandFrequency(int band, int channel, float frequency)
+    {
+        if (band >= 0 && band < NumBands && channel >= 0 && channel < NumChannels)
+            centres[channel][band].store(frequency, std::memory_order_relaxed);
+    }
+
+    template <typename SampleType>
+    void BandEnergyAnalyser::pushSamples(const juce::AudioBuffer<SampleType>& buffer)
+    {
+        if (!enabled.load(std::memory_order_relaxed) || buffer.getNumChannels() == 0)
+            return;
+
+        const int numSamples = buffer.getNumSamples();
+        const int numOut = (decimationCount + numSamples) / decimation;
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(numOut, start1, size1, start2, size2);
+
+        // The analysis thread has fallen behind - drop this block rather than wait
+        if (size1 + size2 < numOut)
+        {
+            decimationCount = 0;
+            decimationSum.fill(0.0f);
+            return;
+        }
+
+        const SampleType* input[NumChannels] = {
+            buffer.getReadPointer(0),
+            buffer.getReadPointer(std::min(1, buffer.getNumChannels() - 1))
+        };
+
+        if (decimation == 1)
+        {
+            for (int ch = 0; ch < NumChannels; ++ch)
+            {
+                float* out = fifoBuffer.getWritePointer(ch);
+
+                for (int i = 0; i < size1; ++i)
+                    out[start1 + i] = static_cast<float>(input[ch][i]);
+
+                for (int i = 0; i < size2; ++i)
+                    out[start2 + i] = static_cast<float>(input[ch][size1 + i]);
+            }
+        }
+        else
+        {
+            const float scale = 1.0f / static_cast<float>(decimation);
+
+            for (int ch = 0; ch < NumChannels; ++ch)
+            {
+                float* out = fifoBuffer.getWritePointer(ch);
+                float sum = decimationSum[ch];
+                int count = decimationCount;
+                int written = 0;
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    sum += static_cast<float>(input[ch][i]);
+
+                    if (++count == decimation)
+                    {
+                        const int index = written < size1 ? start1 + written : start2 + (written - size1);
+                        out[index] = sum * scale;
+                        ++written;
+                        sum = 0.0f;
+                        count = 0;
+                    }
+                }
+
+                decimationSum[ch] = sum;
+
+                if (ch == NumChannels - 1)
+                    decimationCount = count;
+            }
+        }
+
+        fifo.finishedWrite(numOut);
+    }
+
+    float BandEnergyAnalyser::getEnergy(int band, int channel) const
+    {
+        if (band < 0 || band >= NumBands || channel < 0 || channel >= NumChannels)
+            return 0.0f;
+
+        return energies[channel][band].load(std::memory_order_relaxed);
+    }
+
+    int BandEnergyAnalyser::useTimeSlice()
+    {
+        const juce::ScopedLock sl(analysisLock);
+
+        while (fifo.getNumReady() > 0)
+        {
+            int start1, size1, start2, size2;
+            fifo.prepareToRead(fftSize - frameFill, start1, size1, start2, size2);
+
+            for (int ch = 0; ch < NumChannels; ++ch)
+            {
+                frames.copyFrom(ch, frameFill, fifoBuffer, ch, start1, size1);
+                if (size2 > 0)
+                    frames.copyFrom(ch, frameFill + size1, fifoBuffer, ch, start2, size2);
+            }
+
+            fifo.finishedRead(size1 + size2);
+            frameFill += size1 + size2;
+
+            if (frameFill < fftSize)
+                break;
+
+            for (int ch = 0; ch < NumChannels; ++ch)
+            {
+                analyseFrame(ch);
+
+                // Keep the second half as the start of the next, overlapping frame
+                float* frame = frames.getWritePointer(ch);
+                std::copy(frame + hopSize, frame + fftSize, frame);
+            }
+
+            frameFill = fftSize - hopSize;
+        }
+
+        return idleWaitMs;
+    }
+
+    void BandEnergyAnalyser::updateBandWeights(int channel, int band, float centre)
+    {
+        // Gaussian in log-frequency with the same octave bandwidth as the band's default Q
+        const double q = BandDefaults::getQ(band);
+        const double octaves = 2.0 / std::log(2.0) * std::asinh(1.0 / (2.0 * q));
+        const double sigma = octaves / 2.355;
+        const double binWidth = analysisRate / fftSize;
+
+        auto& weights = bandWeights[channel][band];
+        weights[0] = 0.0f;
+
+        for (int k = 1; k <= fftSize / 2; ++k)
+        {
+            const double distance = std::log2(k * binWidth / centre) / sigma;
+            weights[k] = static_cast<float>(std::exp(-0.5 * distance * distance));
+        }
+
+        weightedCentres[channel][band] = centre;
+    }
+
+    void BandEnergyAnalyser::analyseFrame(int channel)
+    {
+        juce::FloatVectorOperations::multiply(fftData.data(), frames.getReadPointer(channel), window.data(), fftSize);
+        std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+        fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+        for (int band = 0; band < NumBands; ++band)
+        {
+            const float centre = centres[channel][band].load(std::memory_order_relaxed);
+            if (centre != weightedCentres[channel][band])
+                updateBandWeights(channel, band, centre);
+
+            const auto& weights = bandWeights[channel][band];
+            float power = 0.0f;
+
+            for (int k = 0; k <= fftSize / 2; ++k)
+                power += weights[k] * fftData[k] * fftData[k];
+
+            energies[channel][band].store(std::sqrt(power * powerScale), std::memory_order_relaxed);
+        }
+    }
+
+    template void BandEnergyAnalyser::pushSamples<float>(const juce::AudioBuffer<float>&);
+    template void BandEnergyAnalyser::pushSamples<double>(const juce::AudioBuffer<double>&);
+}
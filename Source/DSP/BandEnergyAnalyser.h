@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    BandEnergyAnalyser - Background Band Energy Filterbank for the Visualizer
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <juce_core/juce_core.h>
+
+namespace Aetheri
+{
+    /**
+     * Per-band output energy, measured off the audio thread
+     * The audio thread decimates the plugin output and pushes it into a lock-free
+     * single-producer/single-consumer FIFO; a shared background thread drains it,
+     * runs a windowed FFT and folds the spectrum into four log-frequency filters
+     * centred on the EQ band frequencies. Results are published atomically.
+     */
+    class BandEnergyAnalyser : public juce::TimeSliceClient
+    {
+    public:
+        static constexpr int NumBands = 4;
+        static constexpr int NumChannels = 2;
+
+        BandEnergyAnalyser();
+        ~BandEnergyAnalyser() override;
+
+        // Not on the audio thread - resizes the analysis buffers
+        void prepare(double sampleRate);
+
+        // Message thread: attaches to/detaches from the analysis thread while a display is open
+        void setEnabled(bool shouldBeEnabled);
+        bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+        // Audio thread
+        void setBandFrequency(int band, int channel, float frequency);
+        template <typename SampleType>
+        void pushSamples(const juce::AudioBuffer<SampleType>& buffer);
+
+        // Any thread: band RMS level of the most recent analysis frame
+        float getEnergy(int band, int channel) const;
+
+        // Analysis thread
+        int useTimeSlice() override;
+
+    private:
+        static constexpr int fftOrder = 11;
+        static constexpr int fftSize = 1 << fftOrder;
+        static constexpr int hopSize = fftSize / 2;
+        static constexpr int fifoSize = fftSize * 4;
+
+        struct AnalysisThread;
+        juce::SharedResourcePointer<AnalysisThread> analysisThread;
+
+        // Audio thread -> analysis thread
+        juce::AbstractFifo fifo { fifoSize };
+        juce::AudioBuffer<float> fifoBuffer { NumChannels, fifoSize };
+        std::atomic<bool> enabled { false };
+
+        // Decimation by averaging, phase carried across blocks
+        int decimation = 1;
+        int decimationCount = 0;
+        std::array<float, NumChannels> decimationSum {};
+
+        // Analysis thread state
+        juce::CriticalSection analysisLock;
+        juce::dsp::FFT fft { fftOrder };
+        std::array<float, fftSize> window {};
+        std::array<float, fftSize * 2> fftData {};
+        juce::AudioBuffer<float> frames { NumChannels, fftSize };
+        int frameFill = 0;
+        double analysisRate = 44100.0;
+        float powerScale = 1.0f;
+
+        std::array<std::array<float, NumBands>, NumChannels> weightedCentres {};
+        std::array<std::array<std::vector<float>, NumBands>, NumChannels> bandWeights;
+
+        // Shared with the audio and message threads
+        std::array<std::array<std::atomic<float>, NumBands>, NumChannels> centres;
+        std::array<std::array<std::atomic<float>, NumBands>, NumChannels> energies;
+
+        void updateBandWeights(int channel, int band, float centre);
+        void analyseFrame(int channel);
+    };
+}
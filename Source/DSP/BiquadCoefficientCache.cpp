@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    BiquadCoefficientCache Implementation
+  ==============================================================================
+*/
+
+#include "BiquadCoefficientCache.h"
+#include "Parameters.h"
+
+namespace Aetheri
+{
+    namespace
+    {
+        // Quantisation steps of the cache key
+        constexpr double freqStep = 0.01;    // Hz
+        constexpr double gainStep = 0.001;   // dB
+        constexpr double qStep = 0.0001;
+
+        constexpr juce::uint64 qMask = (1u << 28) - 1;
+
+        // Gain grid used by the precomputed table (matches the band gain parameter)
+        constexpr float prewarmGainMin = -10.0f;
+        constexpr float prewarmGainStep = 0.1f;
+        constexpr int prewarmGainSteps = 201;
+    }
+
+    BiquadCoefficientCache::BiquadCoefficientCache()
+        : slots (new Slot[numSlots])
+    {
+    }
+
+    BiquadCoefficientCache::Key BiquadCoefficientCache::makeKey(double sampleRate, Shape shape,
+                                                                float freq, float gainDB, float q)
+    {
+        auto rate = static_cast<juce::uint64>(juce::roundToInt(sampleRate));
+        auto qUnits = static_cast<juce::uint64>(juce::roundToInt(q / qStep)) & qMask;
+        auto freqUnits = static_cast<juce::uint32>(juce::roundToInt(freq / freqStep));
+        auto gainUnits = static_cast<juce::uint32>(juce::roundToInt(gainDB / gainStep));
+
+        Key key;
+        key.rateShapeQ = (rate << 32) | (static_cast<juce::uint64>(shape) << 28) | qUnits;
+        key.freqGain = (static_cast<juce::uint64>(freqUnits) << 32) | gainUnits;
+        return key;
+    }
+
+    juce::uint32 BiquadCoefficientCache::hashKey(const Key& key)
+    {
+        auto h = key.rateShapeQ * 0x9E3779B97F4A7C15ull ^ key.freqGain * 0xC2B2AE3D27D4EB4Full;
+        return static_cast<juce::uint32>(h ^ (h >> 29));
+    }
+
+    bool BiquadCoefficientCache::lookup(const Key& key, BiquadCoefficients& result) const
+    {
+        auto home = hashKey(key);
+
+        for (int probe = 0; probe < maxProbes; ++probe)
+        {
+            const auto& slot = slots[(home + static_cast<juce::uint32>(probe)) & (numSlots - 1)];
+
+            auto before = slot.sequence.load(std::memory_order_acquire);
+            if ((before & 1u) != 0)
+                continue;
+
+            if (slot.rateShapeQ.load(std::memory_order_relaxed) != key.rateShapeQ
+                || slot.freqGain.load(std::memory_order_relaxed) != key.freqGain)
+                continue;
+
+            BiquadCoefficients candidate { slot.b0.load(std::memory_order_relaxed),
+                                           slot.b1.load(std::memory_order_relaxed),
+                                           slot.b2.load(std::memory_order_relaxed),
+                                           slot.a1.load(std::memory_order_relaxed),
+                                           slot.a2.load(std::memory_order_relaxed) };
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // Torn by a concurrent insert - treat as a miss
+            if (slot.sequence.load(std::memory_order_relaxed) != before)
+                return false;
+
+            result = candidate;
+            return true;
+        }
+
+        return false;
+    }
+
+    void BiquadCoefficientCache::insert(const Key& key, const BiquadCoefficients& coeffs)
+    {
+        // Prefer an empty slot in the probe window, otherwise rotate through it
+        auto home = hashKey(key);
+        auto victim = home + insertCounter.fetch_add(1, std::memory_order_relaxed) % maxProbes;
+
+        for (int probe = 0; probe < maxProbes; ++probe)
+        {
+            const auto& slot = slots[(home + static_cast<juce::uint32>(probe)) & (numSlots - 1)];
+
+            if (slot.sequence.load(std::memory_order_relaxed) == 0)
+            {
+                victim = home + static_cast<juce::uint32>(probe);
+                break;
+            }
+        }
+
+        auto& slot = slots[victim & (numSlots - 1)];
+        auto sequence = slot.sequence.load(std::memory_order_relaxed);
+
+        // Another thread is writing this slot - skipping the insert is always safe
+        if ((sequence & 1u) != 0
+            || ! slot.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+            return;
+
+        slot.rateShapeQ.store(key.rateShapeQ, std::memory_order_relaxed);
+        slot.freqGain.store(key.freqGain, std::memory_order_relaxed);
+        slot.b0.store(coeffs.b0, std::memory_order_relaxed);
+        slot.b1.store(coeffs.b1, std::memory_order_relaxed);
+        slot.b2.store(coeffs.b2, std::memory_order_relaxed);
+        slot.a1.store(coeffs.a1, std::memory_order_relaxed);
+        slot.a2.store(coeffs.a2, std::memory_order_relaxed);
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    BiquadCoefficients BiquadCoefficientCache::getCoefficients(const Key& key)
+    {
+        BiquadCoefficients result;
+
+        if (!lookup(key, result))
+        {
+            result = design(key);
+            insert(key, result);
+        }
+
+        return result;
+    }
+
+    BiquadCoefficients BiquadCoefficientCache::design(const Key& key)
+    {
+        const double sampleRate = static_cast<double>(key.rateShapeQ >> 32);
+        const auto shape = static_cast<Shape>((key.rateShapeQ >> 28) & 0xf);
+        const double q = static_cast<double>(key.rateShapeQ & qMask) * qStep;
+        const double freq = static_cast<double>(key.freqGain >> 32) * freqStep;
+        const double gainDB = static_cast<double>(static_cast<juce::int32>(key.freqGain & 0xffffffffu)) * gainStep;
+
+        if (std::abs(gainDB) < 0.01 || sampleRate <= 0.0)
+        {
+            // Bypass - unity gain
+            return {};
+        }
+
+        double A = std::pow(10.0, gainDB / 40.0);
+        double omega = 2.0 * juce::MathConstants<double>::pi * freq / sampleRate;
+        double sinOmega = std::sin(omega);
+        double cosOmega = std::cos(omega);
+        double b0, b1, b2, a0, a1, a2;
+
+        if (shape == Shape::Bell)
+        {
+            // Peak/Bell filter coefficients
+            double alpha = sinOmega / (2.0 * q);
+
+            b0 = 1.0 + alpha * A;
+            b1 = -2.0 * cosOmega;
+            b2 = 1.0 - alpha * A;
+            a0 = 1.0 + alpha / A;
+            a1 = -2.0 * cosOmega;
+            a2 = 1.0 - alpha / A;
+        }
+        else
+        {
+            double S = 1.0;  // Shelf slope
+            double alpha = sinOmega / 2.0 * std::sqrt((A + 1.0 / A) * (1.0 / S - 1.0) + 2.0);
+            double sqrtA_alpha = 2.0 * std::sqrt(A) * alpha;
+
+            if (shape == Shape::HighShelf)
+            {
+                b0 = A * ((A + 1.0) + (A - 1.0) * cosOmega + sqrtA_alpha);
+                b1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * cosOmega);
+                b2 = A * ((A + 1.0) + (A - 1.0) * cosOmega - sqrtA_alpha);
+                a0 = (A + 1.0) - (A - 1.0) * cosOmega + sqrtA_alpha;
+                a1 = 2.0 * ((A - 1.0) - (A + 1.0) * cosOmega);
+                a2 = (A + 1.0) - (A - 1.0) * cosOmega - sqrtA_alpha;
+            }
+            else
+            {
+                b0 = A * ((A + 1.0) - (A - 1.0) * cosOmega + sqrtA_alpha);
+                b1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cosOmega);
+                b2 = A * ((A + 1.0) - (A - 1.0) * cosOmega - sqrtA_alpha);
+                a0 = (A + 1.0) + (A - 1.0) * cosOmega + sqrtA_alpha;
+                a1 = -2.0 * ((A - 1.0) + (A + 1.0) * cosOmega);
+                a2 = (A + 1.0) + (A - 1.0) * cosOmega - sqrtA_alpha;
+            }
+        }
+
+        // Normalize
+        return { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+    }
+
+    void BiquadCoefficientCache::prewarm(double sampleRate)
+    {
+        auto rate = static_cast<juce::uint32>(juce::roundToInt(sampleRate));
+
+        {
+            const juce::ScopedLock sl (prewarmLock);
+
+            if (prewarmedRates.contains(rate))
+                return;
+
+            prewarmedRates.add(rate);
+        }
+
+        for (int band = 0; band < 4; ++band)
+        {
+            float freq = BandDefaults::getDefaultFreq(band);
+            float q = BandDefaults::getQ(band);
+            auto shelf = freq > 2000.0f ? Shape::HighShelf : Shape::LowShelf;
+
+            for (int step = 0; step < prewarmGainSteps; ++step)
+            {
+                float gainDB = prewarmGainMin + prewarmGainStep * static_cast<float>(step);
+
+                for (auto shape : { Shape::Bell, shelf })
+                {
+                    auto key = makeKey(sampleRate, shape, freq, gainDB, q);
+                    insert(key, design(key));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    BiquadCoefficientCache - Process-Wide Bell/Shelf Design Cache
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+#include "BiquadCoefficients.h"
+
+namespace Aetheri
+{
+    /**
+     * Lock-free, read-mostly cache of EQ band designs shared by every plugin instance
+     * in the process (hold it through juce::SharedResourcePointer).
+     *
+     * Designs are keyed by sample rate, shape and quantised frequency/gain/Q, and are
+     * always computed at the quantised values so a hit and a miss give identical
+     * coefficients. Lookups and inserts are wait-free and safe on the audio thread;
+     * a slot being written by another thread simply reads as a miss.
+     */
+    class BiquadCoefficientCache
+    {
+    public:
+        enum class Shape : juce::uint32 { Bell = 0, LowShelf, HighShelf };
+
+        struct Key
+        {
+            juce::uint64 rateShapeQ = 0;   // sample rate (Hz) | shape | Q (1e-4)
+            juce::uint64 freqGain = 0;     // frequency (0.01 Hz) | gain (0.001 dB, offset)
+
+            bool operator==(const Key& other) const { return rateShapeQ == other.rateShapeQ && freqGain == other.freqGain; }
+        };
+
+        BiquadCoefficientCache();
+
+        static Key makeKey(double sampleRate, Shape shape, float freq, float gainDB, float q);
+
+        // Cached design, computed and inserted on a miss
+        BiquadCoefficients getCoefficients(const Key& key);
+        bool lookup(const Key& key, BiquadCoefficients& result) const;
+        void insert(const Key& key, const BiquadCoefficients& coeffs);
+
+        // Uncached design at the key's quantised values
+        static BiquadCoefficients design(const Key& key);
+
+        /**
+         * Precomputed table mode: fills the cache with every gain step of the gain
+         * parameter grid at the BandDefaults frequencies and Q for the given rate.
+         * Runs once per sample rate per process; call from prepare, not the audio thread.
+         */
+        void prewarm(double sampleRate);
+
+        static constexpr int numSlots = 8192;
+        static constexpr int maxProbes = 4;
+
+    private:
+        // Each slot is guarded by its own sequence counter (odd = being written)
+        struct alignas(64) Slot
+        {
+            std::atomic<juce::uint32> sequence { 0 };
+            std::atomic<juce::uint64> rateShapeQ { 0 };
+            std::atomic<juce::uint64> freqGain { 0 };
+            std::atomic<double> b0 { 1.0 }, b1 { 0.0 }, b2 { 0.0 }, a1 { 0.0 }, a2 { 0.0 };
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<juce::uint32> insertCounter { 0 };
+
+        juce::CriticalSection prewarmLock;
+        juce::Array<juce::uint32> prewarmedRates;
+
+        static juce::uint32 hashKey(const Key& key);
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BiquadCoefficientCache)
+    };
+}
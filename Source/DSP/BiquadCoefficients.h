@@ -0,0 +1,364 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    BiquadCoefficients - Normalised 2nd-Order Section Coefficients
+  ==============================================================================
+*/
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+
+namespace Aetheri
+{
+    /**
+     * Normalised biquad coefficients (a0 = 1)
+     * Shared between the per-band designers and the block processing kernels
+     */
+    struct BiquadCoefficients
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0;
+        double a1 = 0.0, a2 = 0.0;
+
+        bool isUnity() const { return b0 == 1.0 && b1 == 0.0 && b2 == 0.0 && a1 == 0.0 && a2 == 0.0; }
+
+        bool operator==(const BiquadCoefficients& other) const
+        {
+            return b0 == other.b0 && b1 == other.b1 && b2 == other.b2 && a1 == other.a1 && a2 == other.a2;
+        }
+        bool operator!=(const BiquadCoefficients& other) const { return !(*this == other); }
+
+        // Samples until the impulse response has fallen by the given factor, set by the
+        // slowest pole (0 for unity, a couple of samples for a pure FIR section)
+        int getDecaySamples(double attenuation) const
+        {
+            if (isUnity())
+                return 0;
+
+            // Poles of z^2 + a1 z + a2: a complex pair sits at radius sqrt(a2)
+            const double discriminant = a1 * a1 - 4.0 * a2;
+            double radius = 0.0;
+
+            if (discriminant < 0.0)
+            {
+                radius = std::sqrt(a2);
+            }
+            else
+            {
+                const double root = std::sqrt(discriminant);
+                radius = 0.5 * std::max(std::abs(a1 + root), std::abs(a1 - root));
+            }
+
+            constexpr double maxDecay = 1 << 22;  // ~90 s at 48 kHz, for poles on the unit circle
+
+            if (radius <= 1.0e-6)
+                return 2;
+            if (radius >= 1.0)
+                return static_cast<int>(maxDecay);
+
+            return 2 + static_cast<int>(std::min(maxDecay, std::ceil(std::log(attenuation) / std::log(radius))));
+        }
+    };
+
+    /**
+     * Section state in transposed direct form II: with silent input the next two outputs
+     * are s1 and s2 - a1 * s1. Every engine's sections convert to and from it, so a filter
+     * can change form (biquad, SVF, parallel) mid-stream and carry on without a step
+     */
+    struct SectionState
+    {
+        double s1 = 0.0, s2 = 0.0;
+
+        // From direct form I history, newest first
+        static SectionState fromDirectForm(const BiquadCoefficients& c, double x1, double x2, double y1, double y2)
+        {
+            return { c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - c.a2 * y2, c.b2 * x1 - c.a2 * y1 };
+        }
+
+        // Output history that continues this state after the given input history
+        void toDirectForm(const BiquadCoefficients& c, double x1, double x2, double& y1, double& y2) const
+        {
+            constexpr double minimumPole = 1.0e-6;
+
+            if (std::abs(c.a2) > minimumPole)
+            {
+                y1 = (c.b2 * x1 - s2) / c.a2;
+                y2 = (c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - s1) / c.a2;
+            }
+            else if (std::abs(c.a1) > minimumPole)
+            {
+                // First order: only the newest output is remembered
+                y1 = (c.b1 * x1 + c.b2 * x2 - s1) / c.a1;
+                y2 = y1;
+            }
+            else
+            {
+                // No feedback - the state is all input history; an identity passes it on
+                y1 = x1;
+                y2 = x2;
+            }
+        }
+    };
+
+    // Control-rate settings for smoothed filter parameters
+    namespace ControlRate
+    {
+        // Samples between coefficient updates while a design is gliding
+        constexpr int defaultInterval = 16;
+        constexpr int maxInterval = 256;
+    }
+
+    /**
+     * Per-sample linear interpolation between two control-rate coefficient designs
+     * next() is called once per sample and lands exactly on the target after numSamples calls
+     */
+    struct BiquadCoefficientRamp
+    {
+        BiquadCoefficients current, target, step;
+        int samplesRemaining = 0;
+
+        void setImmediate(const BiquadCoefficients& coeffs)
+        {
+            current = target = coeffs;
+            samplesRemaining = 0;
+        }
+
+        void rampTo(const BiquadCoefficients& newTarget, int numSamples)
+        {
+            if (numSamples <= 1)
+            {
+                setImmediate(newTarget);
+                return;
+            }
+
+            const double scale = 1.0 / numSamples;
+            target = newTarget;
+            step = { (target.b0 - current.b0) * scale, (target.b1 - current.b1) * scale,
+                     (target.b2 - current.b2) * scale, (target.a1 - current.a1) * scale,
+                     (target.a2 - current.a2) * scale };
+            samplesRemaining = numSamples;
+        }
+
+        const BiquadCoefficients& next()
+        {
+            if (samplesRemaining > 0)
+            {
+                if (--samplesRemaining == 0)
+                {
+                    current = target;
+                }
+                else
+                {
+                    current.b0 += step.b0; current.b1 += step.b1; current.b2 += step.b2;
+                    current.a1 += step.a1; current.a2 += step.a2;
+                }
+            }
+            return current;
+        }
+
+        bool isRamping() const { return samplesRemaining > 0; }
+    };
+
+    /**
+     * Glide from the current design to a new target design, straight through coefficient space
+     * Advanced once per control step; the point reached feeds the per-sample ramp. The
+     * stability region of a normalised biquad (|a2| < 1, |a1| < 1 + a2) is convex, so
+     * every design on the way between two stable ones is stable too
+     */
+    struct BiquadCoefficientGlide
+    {
+        BiquadCoefficients start, target, current;
+        int length = 1;
+        int samplesRemaining = 0;
+
+        void setLength(int numSamples) { length = std::max(1, numSamples); }
+
+        void setImmediate(const BiquadCoefficients& coeffs)
+        {
+            start = target = current = coeffs;
+            samplesRemaining = 0;
+        }
+
+        // Starts from wherever the previous glide had got to
+        void glideTo(const BiquadCoefficients& newTarget)
+        {
+            start = current;
+            target = newTarget;
+            samplesRemaining = length;
+        }
+
+        const BiquadCoefficients& advance(int numSamples)
+        {
+            if (samplesRemaining > 0)
+            {
+                samplesRemaining = std::max(0, samplesRemaining - numSamples);
+
+                if (samplesRemaining == 0)
+                {
+                    current = target;
+                }
+                else
+                {
+                    const double t = 1.0 - static_cast<double>(samplesRemaining) / length;
+                    current = { start.b0 + (target.b0 - start.b0) * t, start.b1 + (target.b1 - start.b1) * t,
+                                start.b2 + (target.b2 - start.b2) * t, start.a1 + (target.a1 - start.a1) * t,
+                                start.a2 + (target.a2 - start.a2) * t };
+                }
+            }
+            return current;
+        }
+
+        bool isGliding() const { return samplesRemaining > 0; }
+    };
+
+    /**
+     * Trapezoidal (topology-preserving) state-variable section for the 32-bit eco engines
+     * Any stable biquad maps onto the SVF integrator gains plus a mix of its outputs,
+     * solved here into state-space form. The integrator gain g = tan(w/2) stays well
+     * scaled at low cutoffs, where direct-form a1/a2 crowd against -2/1 and run out of
+     * float bits; the second integrator is updated by increment for the same reason
+     */
+    struct SVFCoefficients
+    {
+        // Integrator updates, then the output mix of input and both integrator states
+        float k1 = -0.5f, k2 = 0.5f, k3 = 0.5f;
+        float m0 = 1.0f, m1 = 0.0f, m2 = 0.0f;
+
+        bool isUnity() const { return m0 == 1.0f && m1 == 0.0f && m2 == 0.0f; }
+
+        // Solved in 64-bit from the response at DC and Nyquist and the damping
+        static SVFCoefficients fromBiquad(const BiquadCoefficients& c)
+        {
+            const double atNyquist = 1.0 - c.a1 + c.a2;
+            const double atDC = std::max(1.0 + c.a1 + c.a2, 1.0e-30);
+            const double g = std::sqrt(atDC / atNyquist);
+            const double k = 2.0 * (1.0 - c.a2) / (atNyquist * g);
+
+            // High-, band- and low-pass weights reproducing the numerator
+            const double high = (c.b0 - c.b1 + c.b2) / atNyquist;
+            const double band = k * (c.b0 - c.b2) / (1.0 - c.a2);
+            const double low = (c.b0 + c.b1 + c.b2) / atDC;
+
+            // Simper's linear trapezoidal SVF gains
+            const double a1 = 1.0 / (1.0 + g * (g + k));
+            const double a2 = g * a1;
+            const double a3 = g * a2;
+
+            // The high-pass output is x - k*band - low; band and low are read before the update
+            const double mixBand = band - k * high;
+            const double mixLow = low - high;
+            const double throughGain = mixBand * a2 + mixLow * a3;
+
+            SVFCoefficients svf;
+            svf.k1 = static_cast<float>(2.0 * a1 - 1.0);
+            svf.k2 = static_cast<float>(2.0 * a2);
+            svf.k3 = static_cast<float>(2.0 * a3);
+            svf.m0 = static_cast<float>(high + throughGain);
+            svf.m1 = static_cast<float>(mixBand * a1 + mixLow * a2);
+            svf.m2 = static_cast<float>(mixLow - throughGain);
+            return svf;
+        }
+    };
+
+    // 32-bit SVF integrator state
+    struct SVFState
+    {
+        float s1 = 0.0f, s2 = 0.0f;
+
+        // Settled on a constant input: no band-pass energy, low-pass at the input level
+        void setHistory(float lastInput) { s1 = 0.0f; s2 = lastInput; }
+
+        // The integrator update as a biquad denominator: a1 = -trace, a2 = determinant
+        static double getA1(const SVFCoefficients& c) { return -(static_cast<double>(c.k1) + 1.0 - c.k3); }
+
+        // Zero-input response of the mix, matched over two samples
+        SectionState toSectionState(const SVFCoefficients& c) const
+        {
+            const double y0 = static_cast<double>(c.m1) * s1 + static_cast<double>(c.m2) * s2;
+            const double next1 = static_cast<double>(c.k1) * s1 - static_cast<double>(c.k2) * s2;
+            const double next2 = static_cast<double>(c.k2) * s1 + (1.0 - c.k3) * s2;
+            const double y1 = static_cast<double>(c.m1) * next1 + static_cast<double>(c.m2) * next2;
+            return { y0, y1 + getA1(c) * y0 };
+        }
+
+        // Inverse of toSectionState; a section whose integrators don't reach the output
+        // (a unity mix) has no state to match and settles on the input instead
+        static SVFState fromSectionState(const SectionState& state, const SVFCoefficients& c, float lastInput)
+        {
+            const double m1 = c.m1, m2 = c.m2;
+            const double r1 = m1 * c.k1 + m2 * c.k2;
+            const double r2 = -m1 * c.k2 + m2 * (1.0 - c.k3);
+            const double det = m1 * r2 - m2 * r1;
+            const double scale = std::abs(m1) + std::abs(m2);
+
+            if (!(std::abs(det) > 1.0e-9 * scale * scale))
+            {
+                SVFState settled;
+                settled.setHistory(lastInput);
+                return settled;
+            }
+
+            const double y0 = state.s1;
+            const double y1 = state.s2 - getA1(c) * state.s1;
+            return { static_cast<float>((y0 * r2 - m2 * y1) / det), static_cast<float>((m1 * y1 - r1 * y0) / det) };
+        }
+
+        float process(float x, const SVFCoefficients& c)
+        {
+            const float y = c.m0 * x + c.m1 * s1 + c.m2 * s2;
+            const float v = x - s2;
+            s2 += c.k2 * s1 + c.k3 * v;
+            s1 = c.k1 * s1 + c.k2 * v;
+            return y;
+        }
+    };
+
+    /**
+     * Per-sample linear interpolation between two control-rate SVF designs
+     * next() is called once per sample and lands exactly on the target after numSamples calls
+     */
+    struct SVFCoefficientRamp
+    {
+        SVFCoefficients current, target, step;
+        int samplesRemaining = 0;
+
+        void setImmediate(const SVFCoefficients& coeffs)
+        {
+            current = target = coeffs;
+            samplesRemaining = 0;
+        }
+
+        void rampTo(const SVFCoefficients& newTarget, int numSamples)
+        {
+            if (numSamples <= 1)
+            {
+                setImmediate(newTarget);
+                return;
+            }
+
+            const float scale = 1.0f / static_cast<float>(numSamples);
+            target = newTarget;
+            step = { (target.k1 - current.k1) * scale, (target.k2 - current.k2) * scale,
+                     (target.k3 - current.k3) * scale, (target.m0 - current.m0) * scale,
+                     (target.m1 - current.m1) * scale, (target.m2 - current.m2) * scale };
+            samplesRemaining = numSamples;
+        }
+
+        const SVFCoefficients& next()
+        {
+            if (samplesRemaining > 0)
+            {
+                if (--samplesRemaining == 0)
+                {
+                    current = target;
+                }
+                else
+                {
+                    current.k1 += step.k1; current.k2 += step.k2; current.k3 += step.k3;
+                    current.m0 += step.m0; current.m1 += step.m1; current.m2 += step.m2;
+                }
+            }
+            return current;
+        }
+    };
+}
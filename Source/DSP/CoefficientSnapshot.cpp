@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    CoefficientSnapshot Implementation
+  ==============================================================================
+*/
+
+#include "CoefficientSnapshot.h"
+#include "HighLowPassFilters.h"
+
+namespace Aetheri
+{
+    CoefficientSnapshot CoefficientSnapshot::design(const CoefficientTargets& targets, BiquadCoefficientCache& cache,
+                                                    juce::uint32 generation)
+    {
+        CoefficientSnapshot snapshot;
+        snapshot.generation = generation;
+        
+        for (size_t ch = 0; ch < targets.bands.size(); ++ch)
+        {
+            for (size_t band = 0; band < targets.bands[ch].size(); ++band)
+            {
+                const auto& key = targets.bands[ch][band];
+                snapshot.bands[ch][band] = cache.getCoefficients(key);
+                snapshot.bandShapes[ch][band] = key.rateShapeQ;
+            }
+        }
+        
+        snapshot.highPass = HighPassFilter::designCoefficients(targets.highPassFrequency, targets.sampleRate);
+        snapshot.lowPass = LowPassFilter::designCoefficients(targets.lowPassFrequency, targets.sampleRate);
+        return snapshot;
+    }
+    
+    void CoefficientSnapshotBuffer::publish(const CoefficientSnapshot& snapshot)
+    {
+        const juce::SpinLock::ScopedLockType lock(writeLock);
+        
+        buffers[static_cast<size_t>(back)] = snapshot;
+        
+        // Release: the reader that takes this index sees the whole snapshot
+        back = middle.exchange(back | freshFlag, std::memory_order_acq_rel) & indexMask;
+    }
+    
+    const CoefficientSnapshot* CoefficientSnapshotBuffer::fetch()
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshFlag) == 0)
+            return nullptr;
+        
+        front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return &buffers[static_cast<size_t>(front)];
+    }
+}
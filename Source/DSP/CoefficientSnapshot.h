@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    CoefficientSnapshot - Filter Designs Built Off the Audio Thread
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include "BiquadCoefficients.h"
+#include "BiquadCoefficientCache.h"
+
+namespace Aetheri
+{
+    // Everything the filter designs depend on, read from the parameters with the channel link resolved
+    struct CoefficientTargets
+    {
+        static constexpr int numChannels = 2;
+        static constexpr int numBands = 4;
+        
+        double sampleRate = 44100.0;
+        std::array<std::array<BiquadCoefficientCache::Key, numBands>, numChannels> bands {};
+        float highPassFrequency = 30.0f;
+        float lowPassFrequency = 18000.0f;
+    };
+    
+    /**
+     * Complete, immutable set of EQ band and HPF/LPF designs for one parameter state
+     * Built by the designer (message thread, or the audio thread itself while rendering
+     * offline) so the audio thread never runs pow/sin/cos; it only glides towards the
+     * newest snapshot. Generations only go up, so a snapshot that lost a race is ignored
+     */
+    struct CoefficientSnapshot
+    {
+        std::array<std::array<BiquadCoefficients, CoefficientTargets::numBands>, CoefficientTargets::numChannels> bands {};
+        // Sample rate, shape and Q of each band: a change there snaps instead of gliding
+        std::array<std::array<juce::uint64, CoefficientTargets::numBands>, CoefficientTargets::numChannels> bandShapes {};
+        BiquadCoefficients highPass, lowPass;
+        juce::uint32 generation = 0;
+        
+        static CoefficientSnapshot design(const CoefficientTargets& targets, BiquadCoefficientCache& cache,
+                                          juce::uint32 generation);
+    };
+    
+    /**
+     * Lock-free triple buffer from the designer to the audio thread
+     * The writer fills its back buffer and swaps it into the middle; the reader swaps the
+     * middle for its front buffer only when something new is there. Neither side ever waits
+     * on the other, and the reader keeps its snapshot until it asks for the next one.
+     * Writers (message thread, prepareToPlay) are serialised among themselves
+     */
+    class CoefficientSnapshotBuffer
+    {
+    public:
+        CoefficientSnapshotBuffer() = default;
+        
+        // Any thread but the audio thread
+        void publish(const CoefficientSnapshot& snapshot);
+        
+        // Audio thread: the newest published snapshot, or nullptr if none arrived since the last call
+        const CoefficientSnapshot* fetch();
+        
+    private:
+        static constexpr int indexMask = 3;
+        static constexpr int freshFlag = 4;
+        
+        std::array<CoefficientSnapshot, 3> buffers;
+        std::atomic<int> middle { 1 };
+        int back = 0;   // Writer only
+        int front = 2;  // Reader only
+        juce::SpinLock writeLock;
+        
+        JUCE_DECLARE_NON_COPYABLE(CoefficientSnapshotBuffer)
+    };
+}
@@ -9,191 +9,220 @@
 
 namespace Aetheri
 {
-    //==============================================================================
-    // HighPassFilter Implementation
-    //==============================================================================
-    
-    void HighPassFilter::prepare(double newSampleRate, int /*samplesPerBlock*/)
+    namespace
     {
-        sampleRate = newSampleRate;
-        smoothedFreq.reset(sampleRate, 0.02);
-        smoothedFreq.setCurrentAndTargetValue(currentFreq);
-        reset();
-    }
-    
-    void HighPassFilter::reset()
-    {
-        for (auto& state : channelStates)
+        // DF1 biquad over one control step, gliding the coefficients with a local copy of the ramp
+        template <typename SampleType, typename State>
+        void processControlStep(SampleType* data, int numSamples, State& state, BiquadCoefficientRamp ramp)
         {
-            state.x1 = state.x2 = 0.0;
-            state.y1 = state.y2 = 0.0;
-        }
-    }
-    
-    void HighPassFilter::setFrequency(float freq)
-    {
-        if (freq != currentFreq)
-        {
-            currentFreq = freq;
-            smoothedFreq.setTargetValue(freq);
-            needsUpdate = true;
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto& c = ramp.next();
+                double inputD = static_cast<double>(data[i]);
+                
+                double output = c.b0 * inputD + c.b1 * state.x1 + c.b2 * state.x2
+                              - c.a1 * state.y1 - c.a2 * state.y2;
+                
+                state.x2 = state.x1;
+                state.x1 = inputD;
+                state.y2 = state.y1;
+                state.y1 = output;
+                
+                data[i] = static_cast<SampleType>(output);
+            }
         }
-    }
-    
-    void HighPassFilter::updateCoefficients()
-    {
-        if (!needsUpdate && !smoothedFreq.isSmoothing())
-            return;
-        
-        float freq = smoothedFreq.getNextValue();
         
-        // Butterworth 2nd order high-pass
-        double omega = 2.0 * juce::MathConstants<double>::pi * freq / sampleRate;
-        double cosOmega = std::cos(omega);
-        double sinOmega = std::sin(omega);
-        double alpha = sinOmega / (2.0 * 0.707107);  // Q = 1/sqrt(2) for Butterworth
-        
-        double a0 = 1.0 + alpha;
-        
-        b0 = (1.0 + cosOmega) / 2.0 / a0;
-        b1 = -(1.0 + cosOmega) / a0;
-        b2 = (1.0 + cosOmega) / 2.0 / a0;
-        a1 = -2.0 * cosOmega / a0;
-        a2 = (1.0 - alpha) / a0;
-        
-        needsUpdate = smoothedFreq.isSmoothing();
-    }
-    
-    float HighPassFilter::processSample(float input, int channel)
-    {
-        if (!isEnabled || channel < 0 || channel >= 2)
-            return input;
-        
-        updateCoefficients();
-        
-        auto& state = channelStates[channel];
-        double inputD = static_cast<double>(input);
-        
-        double output = b0 * inputD + b1 * state.x1 + b2 * state.x2 
-                       - a1 * state.y1 - a2 * state.y2;
-        
-        state.x2 = state.x1;
-        state.x1 = inputD;
-        state.y2 = state.y1;
-        state.y1 = output;
-        
-        return static_cast<float>(output);
-    }
-    
-    void HighPassFilter::processBlock(juce::AudioBuffer<float>& buffer)
-    {
-        if (!isEnabled)
-            return;
-        
-        int numChannels = std::min(buffer.getNumChannels(), 2);
-        int numSamples = buffer.getNumSamples();
-        
-        for (int ch = 0; ch < numChannels; ++ch)
+        // Eco precision: trapezoidal SVF with float state over one control step. The channels
+        // run in the same loop so their dependency chains overlap, and a settled step reads
+        // the coefficients once
+        template <int NumChannels, typename SampleType>
+        void processSVFControlStep(SampleType* const* channels, int numSamples, SVFState* states, SVFCoefficientRamp ramp)
         {
-            auto* data = buffer.getWritePointer(ch);
-            for (int i = 0; i < numSamples; ++i)
+            // Local copies, so the float state can't alias the float buffer and stays in registers
+            SVFState local[NumChannels];
+            
+            for (int ch = 0; ch < NumChannels; ++ch)
+                local[ch] = states[ch];
+            
+            if (ramp.samplesRemaining > 0)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const auto c = ramp.next();
+                    
+                    for (int ch = 0; ch < NumChannels; ++ch)
+                        channels[ch][i] = static_cast<SampleType>(local[ch].process(static_cast<float>(channels[ch][i]), c));
+                }
+            }
+            else
             {
-                data[i] = processSample(data[i], ch);
+                const auto c = ramp.current;
+                
+                for (int i = 0; i < numSamples; ++i)
+                    for (int ch = 0; ch < NumChannels; ++ch)
+                        channels[ch][i] = static_cast<SampleType>(local[ch].process(static_cast<float>(channels[ch][i]), c));
             }
+            
+            for (int ch = 0; ch < NumChannels; ++ch)
+                states[ch] = local[ch];
         }
     }
     
     //==============================================================================
-    // LowPassFilter Implementation
+    // ButterworthFilter Implementation
     //==============================================================================
     
-    void LowPassFilter::prepare(double newSampleRate, int /*samplesPerBlock*/)
+    template <FilterResponse Response>
+    void ButterworthFilter<Response>::prepare(double newSampleRate, int /*samplesPerBlock*/)
     {
         sampleRate = newSampleRate;
-        smoothedFreq.reset(sampleRate, 0.02);
-        smoothedFreq.setCurrentAndTargetValue(currentFreq);
+        glide.setLength(juce::roundToInt(sampleRate * 0.02));  // 20ms glide
+        setTargetCoefficients(designCoefficients(currentFreq, sampleRate), true);
         reset();
     }
     
-    void LowPassFilter::reset()
+    template <FilterResponse Response>
+    void ButterworthFilter<Response>::reset()
     {
         for (auto& state : channelStates)
         {
             state.x1 = state.x2 = 0.0;
             state.y1 = state.y2 = 0.0;
         }
+        
+        for (auto& state : svfStates)
+            state = {};
     }
     
-    void LowPassFilter::setFrequency(float freq)
+    template <FilterResponse Response>
+    void ButterworthFilter<Response>::setTargetCoefficients(const BiquadCoefficients& target, bool snap)
     {
-        if (freq != currentFreq)
+        if (snap)
+        {
+            glide.setImmediate(target);
+            coeffRamp.setImmediate(target);
+            svfRamp.setImmediate(SVFCoefficients::fromBiquad(target));
+            needsUpdate = false;
+        }
+        else if (target != glide.target)
         {
-            currentFreq = freq;
-            smoothedFreq.setTargetValue(freq);
-            needsUpdate = true;
+            glide.glideTo(target);
         }
     }
     
-    void LowPassFilter::updateCoefficients()
+    template <FilterResponse Response>
+    void ButterworthFilter<Response>::setControlInterval(int numSamples)
+    {
+        controlInterval = juce::jlimit(1, ControlRate::maxInterval, numSamples);
+    }
+    
+    template <FilterResponse Response>
+    void ButterworthFilter<Response>::setEcoPrecision(bool shouldUseEco)
     {
-        if (!needsUpdate && !smoothedFreq.isSmoothing())
+        if (shouldUseEco == ecoPrecision)
             return;
         
-        float freq = smoothedFreq.getNextValue();
+        // Hand each channel's state across so the switch is seamless. The biquad takes
+        // zero input history; the outputs it remembers carry the whole state
+        const auto& biquad = coeffRamp.current;
+        const auto& svf = svfRamp.current;
         
-        // Butterworth 2nd order low-pass
-        double omega = 2.0 * juce::MathConstants<double>::pi * freq / sampleRate;
-        double cosOmega = std::cos(omega);
-        double sinOmega = std::sin(omega);
-        double alpha = sinOmega / (2.0 * 0.707107);
-        
-        double a0 = 1.0 + alpha;
-        
-        b0 = (1.0 - cosOmega) / 2.0 / a0;
-        b1 = (1.0 - cosOmega) / a0;
-        b2 = (1.0 - cosOmega) / 2.0 / a0;
-        a1 = -2.0 * cosOmega / a0;
-        a2 = (1.0 - alpha) / a0;
+        for (size_t ch = 0; ch < channelStates.size(); ++ch)
+        {
+            auto& df1 = channelStates[ch];
+            
+            if (shouldUseEco)
+            {
+                const auto state = SectionState::fromDirectForm(biquad, df1.x1, df1.x2, df1.y1, df1.y2);
+                svfStates[ch] = SVFState::fromSectionState(state, svf, static_cast<float>(df1.x1));
+            }
+            else
+            {
+                df1.x1 = df1.x2 = 0.0;
+                svfStates[ch].toSectionState(svf).toDirectForm(biquad, 0.0, 0.0, df1.y1, df1.y2);
+            }
+        }
         
-        needsUpdate = smoothedFreq.isSmoothing();
+        ecoPrecision = shouldUseEco;
     }
     
-    float LowPassFilter::processSample(float input, int channel)
+    template <FilterResponse Response>
+    BiquadCoefficients ButterworthFilter<Response>::designCoefficients(double freq, double rate)
     {
-        if (!isEnabled || channel < 0 || channel >= 2)
-            return input;
-        
-        updateCoefficients();
-        
-        auto& state = channelStates[channel];
-        double inputD = static_cast<double>(input);
-        
-        double output = b0 * inputD + b1 * state.x1 + b2 * state.x2 
-                       - a1 * state.y1 - a2 * state.y2;
+        // Butterworth 2nd order high-pass or low-pass
+        double omega = 2.0 * juce::MathConstants<double>::pi * freq / rate;
+        double cosOmega = std::cos(omega);
+        double sinOmega = std::sin(omega);
+        double alpha = sinOmega / (2.0 * 0.707107);  // Q = 1/sqrt(2) for Butterworth
         
-        state.x2 = state.x1;
-        state.x1 = inputD;
-        state.y2 = state.y1;
-        state.y1 = output;
+        double a0 = 1.0 + alpha;
         
-        return static_cast<float>(output);
+        if constexpr (Response == FilterResponse::HighPass)
+        {
+            return { (1.0 + cosOmega) / 2.0 / a0,
+                     -(1.0 + cosOmega) / a0,
+                     (1.0 + cosOmega) / 2.0 / a0,
+                     -2.0 * cosOmega / a0,
+                     (1.0 - alpha) / a0 };
+        }
+        else
+        {
+            return { (1.0 - cosOmega) / 2.0 / a0,
+                     (1.0 - cosOmega) / a0,
+                     (1.0 - cosOmega) / 2.0 / a0,
+                     -2.0 * cosOmega / a0,
+                     (1.0 - alpha) / a0 };
+        }
     }
     
-    void LowPassFilter::processBlock(juce::AudioBuffer<float>& buffer)
+    template <FilterResponse Response>
+    template <typename SampleType>
+    void ButterworthFilter<Response>::processBlock(const juce::dsp::AudioBlock<SampleType>& block)
     {
         if (!isEnabled)
             return;
         
-        int numChannels = std::min(buffer.getNumChannels(), 2);
-        int numSamples = buffer.getNumSamples();
+        int numChannels = std::min(static_cast<int>(block.getNumChannels()), 2);
+        int numSamples = static_cast<int>(block.getNumSamples());
         
-        for (int ch = 0; ch < numChannels; ++ch)
+        for (int start = 0; start < numSamples;)
         {
-            auto* data = buffer.getWritePointer(ch);
-            for (int i = 0; i < numSamples; ++i)
+            // One glide timeline for all channels, one point on it per control step
+            int stepLength = glide.isGliding() ? std::min(controlInterval, numSamples - start)
+                                               : numSamples - start;
+            
+            if (glide.isGliding())
+            {
+                glide.advance(stepLength);
+                needsUpdate = true;
+            }
+            
+            if (needsUpdate)
+            {
+                coeffRamp.rampTo(glide.current, stepLength);
+                svfRamp.rampTo(SVFCoefficients::fromBiquad(glide.current), stepLength);
+                needsUpdate = false;
+            }
+            
+            if (ecoPrecision)
             {
-                data[i] = processSample(data[i], ch);
+                SampleType* channels[2] = { block.getChannelPointer(0) + start,
+                                            numChannels > 1 ? block.getChannelPointer(1) + start : nullptr };
+                
+                if (numChannels > 1)
+                    processSVFControlStep<2>(channels, stepLength, svfStates.data(), svfRamp);
+                else
+                    processSVFControlStep<1>(channels, stepLength, svfStates.data(), svfRamp);
             }
+            else
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                    processControlStep(block.getChannelPointer(static_cast<size_t>(ch)) + start, stepLength, channelStates[ch], coeffRamp);
+            }
+            
+            coeffRamp.setImmediate(coeffRamp.target);
+            svfRamp.setImmediate(svfRamp.target);
+            start += stepLength;
         }
     }
     
@@ -213,10 +242,44 @@ namespace Aetheri
         lpf.reset();
     }
     
-    void FilterSection::processBlock(juce::AudioBuffer<float>& buffer)
+    void FilterSection::setTargetCoefficients(const BiquadCoefficients& highPass, const BiquadCoefficients& lowPass, bool snap)
+    {
+        hpf.setTargetCoefficients(highPass, snap);
+        lpf.setTargetCoefficients(lowPass, snap);
+    }
+    
+    int FilterSection::getTailSamples(double attenuation) const
+    {
+        return hpf.getTargetCoefficients().getDecaySamples(attenuation)
+             + lpf.getTargetCoefficients().getDecaySamples(attenuation);
+    }
+    
+    void FilterSection::setControlInterval(int numSamples)
+    {
+        hpf.setControlInterval(numSamples);
+        lpf.setControlInterval(numSamples);
+    }
+    
+    void FilterSection::setEcoPrecision(bool shouldUseEco)
+    {
+        hpf.setEcoPrecision(shouldUseEco);
+        lpf.setEcoPrecision(shouldUseEco);
+    }
+    
+    template <typename SampleType>
+    void FilterSection::processBlock(const juce::dsp::AudioBlock<SampleType>& block)
     {
         // HPF first, then LPF
-        hpf.processBlock(buffer);
-        lpf.processBlock(buffer);
+        hpf.processBlock(block);
+        lpf.processBlock(block);
     }
+    
+    template class ButterworthFilter<FilterResponse::HighPass>;
+    template class ButterworthFilter<FilterResponse::LowPass>;
+    template void HighPassFilter::processBlock<float>(const juce::dsp::AudioBlock<float>&);
+    template void HighPassFilter::processBlock<double>(const juce::dsp::AudioBlock<double>&);
+    template void LowPassFilter::processBlock<float>(const juce::dsp::AudioBlock<float>&);
+    template void LowPassFilter::processBlock<double>(const juce::dsp::AudioBlock<double>&);
+    template void FilterSection::processBlock<float>(const juce::dsp::AudioBlock<float>&);
+    template void FilterSection::processBlock<double>(const juce::dsp::AudioBlock<double>&);
 }
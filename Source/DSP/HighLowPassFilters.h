@@ -9,97 +9,90 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
 #include <juce_core/juce_core.h>
+#include "BiquadCoefficients.h"
 
 namespace Aetheri
 {
-    /**
-     * High-Pass Filter with 12 dB/octave slope
-     * Butterworth response for flat passband
-     */
-    class HighPassFilter
+    enum class FilterResponse
     {
-    public:
-        HighPassFilter() = default;
-        
-        void prepare(double sampleRate, int samplesPerBlock);
-        void reset();
-        
-        void setEnabled(bool enabled) { isEnabled = enabled; }
-        void setFrequency(float freq);
-        
-        void processBlock(juce::AudioBuffer<float>& buffer);
-        float processSample(float input, int channel);
-        
-        bool getEnabled() const { return isEnabled; }
-        float getFrequency() const { return currentFreq; }
-        
-    private:
-        bool isEnabled = false;
-        float currentFreq = 30.0f;
-        double sampleRate = 44100.0;
-        
-        juce::SmoothedValue<float> smoothedFreq;
-        bool needsUpdate = true;
-        
-        // 2nd order Butterworth (12 dB/oct) - implemented as cascaded biquad
-        struct BiquadState
-        {
-            double x1 = 0.0, x2 = 0.0;
-            double y1 = 0.0, y2 = 0.0;
-        };
-        
-        std::array<BiquadState, 2> channelStates;  // Stereo
-        
-        // Coefficients
-        double b0 = 1.0, b1 = 0.0, b2 = 0.0;
-        double a1 = 0.0, a2 = 0.0;
-        
-        void updateCoefficients();
+        HighPass,
+        LowPass
     };
     
     /**
-     * Low-Pass Filter with 12 dB/octave slope
-     * Butterworth response for flat passband
+     * High- or low-pass filter with 12 dB/octave slope
+     * Butterworth response for flat passband. Both responses share the glide, the
+     * control-rate ramps and the eco form; only the design differs
      */
-    class LowPassFilter
+    template <FilterResponse Response>
+    class ButterworthFilter
     {
     public:
-        LowPassFilter() = default;
+        ButterworthFilter() = default;
         
         void prepare(double sampleRate, int samplesPerBlock);
         void reset();
         
         void setEnabled(bool enabled) { isEnabled = enabled; }
-        void setFrequency(float freq);
+        // Display value only - the design arrives through setTargetCoefficients()
+        void setFrequency(float freq) { currentFreq = freq; }
+        void setControlInterval(int numSamples);
+        // 32-bit state-variable form instead of the 64-bit biquad
+        void setEcoPrecision(bool shouldUseEco);
+        
+        // Glides to a design made off the audio thread (or jumps to it)
+        void setTargetCoefficients(const BiquadCoefficients& target, bool snap);
         
-        void processBlock(juce::AudioBuffer<float>& buffer);
-        float processSample(float input, int channel);
+        // Advances the glide once per control step for all channels
+        template <typename SampleType>
+        void processBlock(const juce::dsp::AudioBlock<SampleType>& block);
+        
+        // Hands one channel's history to another, e.g. after running only one of them
+        void copyChannelState(int source, int destination)
+        {
+            channelStates[destination] = channelStates[source];
+            svfStates[destination] = svfStates[source];
+        }
         
         bool getEnabled() const { return isEnabled; }
         float getFrequency() const { return currentFreq; }
+        bool isNeutral() const { return !isEnabled; }
+        
+        // Where the glide lands (unity when off), for the linear-phase EQ
+        BiquadCoefficients getTargetCoefficients() const { return isEnabled ? glide.target : BiquadCoefficients {}; }
+        
+        static BiquadCoefficients designCoefficients(double freq, double rate);
         
     private:
         bool isEnabled = false;
-        float currentFreq = 18000.0f;
+        float currentFreq = Response == FilterResponse::HighPass ? 30.0f : 18000.0f;
         double sampleRate = 44100.0;
         
-        juce::SmoothedValue<float> smoothedFreq;
-        bool needsUpdate = true;
+        BiquadCoefficientGlide glide;
+        bool needsUpdate = false;
         
+        // 2nd order Butterworth (12 dB/oct) - implemented as cascaded biquad
         struct BiquadState
         {
             double x1 = 0.0, x2 = 0.0;
             double y1 = 0.0, y2 = 0.0;
         };
         
-        std::array<BiquadState, 2> channelStates;
+        std::array<BiquadState, 2> channelStates;  // Stereo
         
-        double b0 = 1.0, b1 = 0.0, b2 = 0.0;
-        double a1 = 0.0, a2 = 0.0;
+        // Coefficients, interpolated per sample between control-rate designs
+        BiquadCoefficientRamp coeffRamp;
+        int controlInterval = ControlRate::defaultInterval;
         
-        void updateCoefficients();
+        // Eco precision: the same designs as SVF sections with float state
+        bool ecoPrecision = false;
+        std::array<SVFState, 2> svfStates;
+        SVFCoefficientRamp svfRamp;
     };
     
+    using HighPassFilter = ButterworthFilter<FilterResponse::HighPass>;
+    using LowPassFilter = ButterworthFilter<FilterResponse::LowPass>;
+    
     /**
      * Combined HPF/LPF Section
      */
@@ -117,11 +110,28 @@ namespace Aetheri
         void setLPFEnabled(bool enabled) { lpf.setEnabled(enabled); }
         void setLPFFrequency(float freq) { lpf.setFrequency(freq); }
         
-        void processBlock(juce::AudioBuffer<float>& buffer);
+        void setTargetCoefficients(const BiquadCoefficients& highPass, const BiquadCoefficients& lowPass, bool snap);
+        
+        void setControlInterval(int numSamples);
+        void setEcoPrecision(bool shouldUseEco);
+        
+        template <typename SampleType>
+        void processBlock(const juce::dsp::AudioBlock<SampleType>& block);
         
         HighPassFilter& getHPF() { return hpf; }
         LowPassFilter& getLPF() { return lpf; }
         
+        bool isNeutral() const { return hpf.isNeutral() && lpf.isNeutral(); }
+        
+        // Decay of the enabled filters in series once the input stops
+        int getTailSamples(double attenuation) const;
+        
+        void copyChannelState(int source, int destination)
+        {
+            hpf.copyChannelState(source, destination);
+            lpf.copyChannelState(source, destination);
+        }
+        
     private:
         HighPassFilter hpf;
         LowPassFilter lpf;
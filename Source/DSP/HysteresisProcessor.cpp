@@ -11,12 +11,7 @@ namespace Aetheri
 {
     void HysteresisProcessor::prepare(double newSampleRate, int /*samplesPerBlock*/)
     {
-        sampleRate = newSampleRate;
-        
-        // Smooth parameter changes over 20ms
-        tubeAmount.reset(sampleRate, 0.02);
-        transformerAmount.reset(sampleRate, 0.02);
-        mixAmount.reset(sampleRate, 0.02);
+        setOversampling(newSampleRate, 1);
         
         tubeAmount.setCurrentAndTargetValue(0.0f);
         transformerAmount.setCurrentAndTargetValue(0.0f);
@@ -25,6 +20,29 @@ namespace Aetheri
         reset();
     }
     
+    void HysteresisProcessor::setOversampling(double hostSampleRate, int factor)
+    {
+        factor = std::max(1, factor);
+        sampleRate = hostSampleRate * factor;
+        
+        // Smooth parameter changes over 20ms. reset() snaps to the target, so a glide in
+        // progress is picked up again from where it was
+        for (auto* smoother : { &tubeAmount, &transformerAmount, &mixAmount })
+        {
+            const float current = smoother->getCurrentValue();
+            const float target = smoother->getTargetValue();
+            
+            smoother->reset(sampleRate, 0.02);
+            smoother->setCurrentAndTargetValue(current);
+            smoother->setTargetValue(target);
+        }
+        
+        // Same time constants in samples of the host rate
+        tubeSmoothing = std::pow(0.95, 1.0 / factor);
+        dcPole = std::pow(0.995, 1.0 / factor);
+        hysteresisRate = 1.0 / factor;
+    }
+    
     void HysteresisProcessor::reset()
     {
         for (auto& state : channelStates)
@@ -65,26 +83,63 @@ namespace Aetheri
         return std::min(1.0f, (tubeVal + transVal) * 1.5f);
     }
     
-    float HysteresisProcessor::processTube(float input, ChannelState& state, float amount)
+    bool HysteresisProcessor::isNeutral() const
+    {
+        if (!isEnabled)
+            return true;
+        
+        if (tubeAmount.isSmoothing() || transformerAmount.isSmoothing() || mixAmount.isSmoothing())
+            return false;
+        
+        // Fully dry, or nothing to saturate (the DC blocker alone isn't worth a pass)
+        return mixAmount.getTargetValue() <= 0.0f
+            || (tubeAmount.getTargetValue() < 0.001f && transformerAmount.getTargetValue() < 0.001f);
+    }
+    
+    int HysteresisProcessor::getTailSamples(double attenuation) const
+    {
+        if (isNeutral())
+            return 0;
+        
+        // One-pole decays in series, with their host-rate coefficients (the oversampled
+        // ones are stretched to the same time constants)
+        const double logAttenuation = std::log(attenuation);
+        auto decay = [logAttenuation](double pole) { return static_cast<int>(std::ceil(logAttenuation / std::log(pole))); };
+        
+        int tail = decay(0.995);
+        
+        if (tubeAmount.getTargetValue() >= 0.001f)
+            tail += decay(0.95);
+        
+        // With the input at rest the magnetic lag relaxes at its slower, falling rate
+        if (transformerAmount.getTargetValue() >= 0.001f)
+            tail += decay(1.0 - 0.08 * transformerAmount.getTargetValue());
+        
+        return tail;
+    }
+    
+    template <typename SampleType>
+    SampleType HysteresisProcessor::processTube(SampleType input, ChannelState& state, float amount)
     {
         if (amount < 0.001f)
             return input;
         
         // Pre-emphasis on high frequencies for "air" effect
-        float highFreqContent = input - static_cast<float>(state.tubeState);
-        state.tubeState = state.tubeState * 0.95 + input * 0.05;  // Simple lowpass for state
+        SampleType highFreqContent = input - static_cast<SampleType>(state.tubeState);
+        state.tubeState = state.tubeState * tubeSmoothing + input * (1.0 - tubeSmoothing);  // Simple lowpass for state
         
         // Apply tube saturation (odd harmonics)
-        float saturated = softClipOdd(input + highFreqContent * amount * 0.5f);
+        SampleType saturated = softClipOdd(input + highFreqContent * amount * SampleType(0.5));
         
         // Add subtle odd harmonic distortion
-        float harmonics = saturated - input;
+        SampleType harmonics = saturated - input;
         
         // Mix based on amount
-        return input + harmonics * amount * 2.0f;
+        return input + harmonics * amount * SampleType(2);
     }
     
-    float HysteresisProcessor::processTransformer(float input, ChannelState& state, float amount)
+    template <typename SampleType>
+    SampleType HysteresisProcessor::processTransformer(SampleType input, ChannelState& state, float amount)
     {
         if (amount < 0.001f)
             return input;
@@ -96,7 +151,7 @@ namespace Aetheri
         double diff = inputD - state.prevInput;
         
         // Hysteresis curve - output lags behind input slightly, creating phase relationships
-        double hystCoeff = 0.1 * amount;
+        double hystCoeff = 0.1 * amount * hysteresisRate;
         double targetState = inputD;
         
         // If signal is rising, state follows faster; if falling, slower (magnetic lag)
@@ -112,37 +167,30 @@ namespace Aetheri
         state.prevInput = inputD;
         
         // Apply even-order saturation
-        float combined = static_cast<float>(inputD * 0.7 + state.hystState * 0.3);
-        float saturated = softClipEven(combined * (1.0f + amount * 0.5f));
+        SampleType combined = static_cast<SampleType>(inputD * 0.7 + state.hystState * 0.3);
+        SampleType saturated = softClipEven(combined * (SampleType(1) + amount * SampleType(0.5)));
         
         // Bass emphasis from transformer core behavior
-        float lowFreqBoost = static_cast<float>(state.hystState) * amount * 0.1f;
+        SampleType lowFreqBoost = static_cast<SampleType>(state.hystState) * amount * SampleType(0.1);
         
         return saturated + lowFreqBoost;
     }
     
-    float HysteresisProcessor::processDCBlock(float input, ChannelState& state)
+    template <typename SampleType>
+    SampleType HysteresisProcessor::processDCBlock(SampleType input, ChannelState& state)
     {
         // Simple DC blocking filter: y[n] = x[n] - x[n-1] + 0.995 * y[n-1]
-        double output = input - state.dcX + 0.995 * state.dcY;
+        double output = input - state.dcX + dcPole * state.dcY;
         state.dcX = input;
         state.dcY = output;
-        return static_cast<float>(output);
+        return static_cast<SampleType>(output);
     }
     
-    float HysteresisProcessor::processSample(float input, int channel)
+    template <typename SampleType>
+    SampleType HysteresisProcessor::processSample(SampleType input, ChannelState& state, float tube, float transformer, float mix)
     {
-        if (!isEnabled || channel < 0 || channel >= 2)
-            return input;
-        
-        auto& state = channelStates[channel];
-        
-        float tube = tubeAmount.getNextValue();
-        float transformer = transformerAmount.getNextValue();
-        float mix = mixAmount.getNextValue();
-        
         // Process through saturation stages
-        float processed = input;
+        SampleType processed = input;
         
         // Tube stage (odd harmonics, high-frequency emphasis)
         processed = processTube(processed, state, tube);
@@ -154,25 +202,68 @@ namespace Aetheri
         processed = processDCBlock(processed, state);
         
         // Dry/wet mix
-        return input * (1.0f - mix) + processed * mix;
+        return input * (SampleType(1) - mix) + processed * mix;
     }
     
-    void HysteresisProcessor::processBlock(juce::AudioBuffer<float>& buffer)
+    template <typename SampleType>
+    void HysteresisProcessor::processBlock(const juce::dsp::AudioBlock<SampleType>& block)
     {
         if (!isEnabled)
             return;
         
-        int numChannels = std::min(buffer.getNumChannels(), 2);
-        int numSamples = buffer.getNumSamples();
+        int numChannels = std::min(static_cast<int>(block.getNumChannels()), 2);
+        int numSamples = static_cast<int>(block.getNumSamples());
+        
+        if (needsResumePriming && numSamples > 0)
+        {
+            // Coming back from being skipped: start every state from the current signal
+            // level instead of whatever it held when the stage went neutral
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto& state = channelStates[channel];
+                double x = block.getSample(channel, 0);
+                state.tubeState = state.hystState = state.prevInput = x;
+                state.dcX = state.dcY = x;
+            }
+            needsResumePriming = false;
+        }
+        
+        bool smoothing = tubeAmount.isSmoothing() || transformerAmount.isSmoothing() || mixAmount.isSmoothing();
+        
+        if (!smoothing)
+        {
+            float tube = tubeAmount.getCurrentValue();
+            float transformer = transformerAmount.getCurrentValue();
+            float mix = mixAmount.getCurrentValue();
+            
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* data = block.getChannelPointer(static_cast<size_t>(channel));
+                auto& state = channelStates[channel];
+                
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    data[i] = processSample(data[i], state, tube, transformer, mix);
+                }
+            }
+            return;
+        }
         
-        for (int channel = 0; channel < numChannels; ++channel)
+        // Smoothing: advance the parameters once per sample frame, shared by both channels
+        for (int i = 0; i < numSamples; ++i)
         {
-            auto* data = buffer.getWritePointer(channel);
+            float tube = tubeAmount.getNextValue();
+            float transformer = transformerAmount.getNextValue();
+            float mix = mixAmount.getNextValue();
             
-            for (int i = 0; i < numSamples; ++i)
+            for (int channel = 0; channel < numChannels; ++channel)
             {
-                data[i] = processSample(data[i], channel);
+                auto* data = block.getChannelPointer(static_cast<size_t>(channel));
+                data[i] = processSample(data[i], channelStates[channel], tube, transformer, mix);
             }
         }
     }
+    
+    template void HysteresisProcessor::processBlock<float>(const juce::dsp::AudioBlock<float>&);
+    template void HysteresisProcessor::processBlock<double>(const juce::dsp::AudioBlock<double>&);
 }
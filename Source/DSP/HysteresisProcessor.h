@@ -28,17 +28,33 @@ namespace Aetheri
         void prepare(double sampleRate, int samplesPerBlock);
         void reset();
         
+        // Runs the stage at factor x the host rate; its filters keep their host-rate response,
+        // so oversampling only changes the aliasing. The settings keep their values, and a glide
+        // in progress carries on from where it was over a fresh 20 ms at the new rate
+        void setOversampling(double hostSampleRate, int factor);
+        
         void setEnabled(bool enabled) { isEnabled = enabled; }
         void setTubeHarmonics(float amount);    // 0-100%
         void setTransformerSaturate(float amount);  // 0-100%
         void setMix(float mixPercent);  // 0-100%
         
-        void processBlock(juce::AudioBuffer<float>& buffer);
-        float processSample(float input, int channel);
+        template <typename SampleType>
+        void processBlock(const juce::dsp::AudioBlock<SampleType>& block);
         
         bool getEnabled() const { return isEnabled; }
         float getGlowIntensity() const;  // For UI glow effect
         
+        // True when the stage leaves the signal untouched (disabled, dry, or no saturation)
+        bool isNeutral() const;
+        // Called when the stage rejoins the chain after being skipped as neutral
+        void resume() { needsResumePriming = true; }
+        // Hands one channel's saturation state to another, e.g. after running only one of them
+        void copyChannelState(int source, int destination) { channelStates[destination] = channelStates[source]; }
+        
+        // Host-rate samples until the tube, transformer and DC blocker states have fallen
+        // by the given factor once the input stops
+        int getTailSamples(double attenuation) const;
+        
     private:
         bool isEnabled = false;
         
@@ -49,6 +65,11 @@ namespace Aetheri
         
         double sampleRate = 44100.0;
         
+        // Per-sample coefficients, stretched to the oversampling factor
+        double tubeSmoothing = 0.95;
+        double dcPole = 0.995;
+        double hysteresisRate = 1.0;
+        
         // State for each channel
         struct ChannelState
         {
@@ -65,56 +86,67 @@ namespace Aetheri
         };
         
         std::array<ChannelState, 2> channelStates;
+        bool needsResumePriming = false;
         
         // Tube saturation (odd harmonics - asymmetric soft clipping)
-        float processTube(float input, ChannelState& state, float amount);
+        template <typename SampleType>
+        SampleType processTube(SampleType input, ChannelState& state, float amount);
         
         // Transformer saturation (even harmonics - symmetric saturation with hysteresis)
-        float processTransformer(float input, ChannelState& state, float amount);
+        template <typename SampleType>
+        SampleType processTransformer(SampleType input, ChannelState& state, float amount);
         
         // DC blocking filter
-        float processDCBlock(float input, ChannelState& state);
+        template <typename SampleType>
+        SampleType processDCBlock(SampleType input, ChannelState& state);
+        
+        template <typename SampleType>
+        SampleType processSample(SampleType input, ChannelState& state, float tube, float transformer, float mix);
         
         // Soft clipping functions
-        static float softClipOdd(float x);   // Odd harmonics (tanh-like)
-        static float softClipEven(float x);  // Even harmonics (parabolic)
+        template <typename SampleType>
+        static SampleType softClipOdd(SampleType x);   // Odd harmonics (tanh-like)
+        template <typename SampleType>
+        static SampleType softClipEven(SampleType x);  // Even harmonics (parabolic)
     };
     
     //==============================================================================
     // Inline implementations for saturation functions
     //==============================================================================
     
-    inline float HysteresisProcessor::softClipOdd(float x)
+    template <typename SampleType>
+    inline SampleType HysteresisProcessor::softClipOdd(SampleType x)
     {
         // Asymmetric soft clipping for odd harmonics
         // Uses a combination of tanh and polynomial
-        if (std::abs(x) < 0.5f)
+        if (std::abs(x) < SampleType(0.5))
         {
-            return x * (1.0f - 0.15f * x * x);
+            return x * (SampleType(1) - SampleType(0.15) * x * x);
         }
-        return std::tanh(x * 1.2f) * 0.9f;
+        return std::tanh(x * SampleType(1.2)) * SampleType(0.9);
     }
     
-    inline float HysteresisProcessor::softClipEven(float x)
+    template <typename SampleType>
+    inline SampleType HysteresisProcessor::softClipEven(SampleType x)
     {
         // Symmetric saturation with even harmonic emphasis
         // Soft knee compression curve
-        float absX = std::abs(x);
-        if (absX < 0.3f)
+        SampleType absX = std::abs(x);
+        if (absX < SampleType(0.3))
         {
             return x;
         }
-        else if (absX < 0.8f)
+        else if (absX < SampleType(0.8))
         {
             // Add subtle even harmonics
-            float sign = (x > 0.0f) ? 1.0f : -1.0f;
-            return sign * (0.3f + (absX - 0.3f) * 0.8f + 0.1f * x * x);
+            SampleType sign = (x > SampleType(0)) ? SampleType(1) : SampleType(-1);
+            return sign * (SampleType(0.3) + (absX - SampleType(0.3)) * SampleType(0.8) + SampleType(0.1) * x * x);
         }
         else
         {
             // Soft limiting
-            float sign = (x > 0.0f) ? 1.0f : -1.0f;
-            return sign * (0.7f + std::tanh((absX - 0.8f) * 2.0f) * 0.25f);
+            SampleType sign = (x > SampleType(0)) ? SampleType(1) : SampleType(-1);
+            return sign * (SampleType(0.7) + std::tanh((absX - SampleType(0.8)) * SampleType(2)) * SampleType(0.25));
         }
     }
 }
@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    LinearPhaseEQ Implementation
+  ==============================================================================
+*/
+
+#include "LinearPhaseEQ.h"
+#include <complex>
+
+namespace Aetheri
+{
+    namespace
+    {
+        // Longest wait between polls for a new response (ms); also caps the redesign
+        // rate while parameters are automated
+        constexpr int designIntervalMs = 20;
+
+        std::complex<double> sectionResponse(const BiquadCoefficients& c, std::complex<double> z1)
+        {
+            const auto z2 = z1 * z1;
+            return (c.b0 + c.b1 * z1 + c.b2 * z2) / (1.0 + c.a1 * z1 + c.a2 * z2);
+        }
+    }
+
+    /** Low-priority thread shared by all instances for FIR redesigns */
+    struct LinearPhaseEQ::DesignThread : public juce::TimeSliceThread
+    {
+        DesignThread() : juce::TimeSliceThread("Aetheri Linear Phase Design")
+        {
+            startThread(juce::Thread::Priority::low);
+        }
+
+        ~DesignThread() override
+        {
+            stopThread(1000);
+        }
+    };
+
+    bool LinearPhaseEQ::Response::operator==(const Response& other) const
+    {
+        for (int ch = 0; ch < NumChannels; ++ch)
+        {
+            for (int s = 0; s < NumSections; ++s)
+            {
+                const auto& a = sections[ch][s];
+                const auto& b = other.sections[ch][s];
+
+                if (a.b0 != b.b0 || a.b1 != b.b1 || a.b2 != b.b2 || a.a1 != b.a1 || a.a2 != b.a2)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    LinearPhaseEQ::LinearPhaseEQ()
+    {
+        designThread->addTimeSliceClient(this);
+    }
+
+    LinearPhaseEQ::~LinearPhaseEQ()
+    {
+        designThread->removeTimeSliceClient(this);
+    }
+
+    int LinearPhaseEQ::getFilterLength(double sampleRate)
+    {
+        // ~85 ms of FIR at every rate: enough resolution for the LF shelf at 20 Hz
+        int length = 4096;
+
+        while (length * 48000.0 < 4096.0 * sampleRate * 0.999)
+            length *= 2;
+
+        return length;
+    }
+
+    void LinearPhaseEQ::prepare(double newSampleRate, int samplesPerBlock)
+    {
+        const juce::ScopedLock sl(designLock);
+
+        sampleRate = newSampleRate;
+        filterLength = getFilterLength(sampleRate);
+        maxBlockSize = std::max(1, samplesPerBlock);
+        conversionBuffer.setSize(NumChannels, maxBlockSize);
+        fft = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(filterLength)));
+        spectrum.allocate(static_cast<size_t>(filterLength * 2), true);
+
+        // Start from the latest response, or a pure delay before the mode was ever used,
+        // so the reported latency holds from the first block the new filter is live
+        juce::AudioBuffer<float> initial;
+
+        if (hasRequested)
+        {
+            initial = designFilter(lastRequested);
+        }
+        else
+        {
+            initial.setSize(NumChannels, filterLength);
+            initial.clear();
+
+            for (int ch = 0; ch < NumChannels; ++ch)
+                initial.setSample(ch, filterLength / 2, 1.0f);
+        }
+
+        convolution.loadImpulseResponse(std::move(initial), sampleRate,
+                                        juce::dsp::Convolution::Stereo::yes,
+                                        juce::dsp::Convolution::Trim::no,
+                                        juce::dsp::Convolution::Normalise::no);
+        designedVersion = pendingVersion.load();
+
+        convolution.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock),
+                              static_cast<juce::uint32>(NumChannels) });
+    }
+
+    void LinearPhaseEQ::reset()
+    {
+        convolution.reset();
+    }
+
+    void LinearPhaseEQ::setResponse(const Response& response)
+    {
+        if (hasRequested && response == lastRequested)
+            return;
+
+        const juce::SpinLock::ScopedTryLockType lock(pendingLock);
+
+        if (!lock.isLocked())
+            return;
+
+        pending = response;
+        pendingVersion.fetch_add(1);
+        lastRequested = response;
+        hasRequested = true;
+    }
+
+    template <typename SampleType>
+    void LinearPhaseEQ::process(SampleType* left, SampleType* right, int numSamples)
+    {
+        SampleType* channels[NumChannels] = { left, right };
+
+        // The convolution is prepared for blocks of at most maxBlockSize (oversampled
+        // blocks are longer)
+        for (int start = 0; start < numSamples; start += maxBlockSize)
+        {
+            const int length = std::min(maxBlockSize, numSamples - start);
+
+            if constexpr (std::is_same_v<SampleType, float>)
+            {
+                juce::dsp::AudioBlock<float> block(channels, NumChannels, static_cast<size_t>(start),
+                                                   static_cast<size_t>(length));
+                juce::dsp::ProcessContextReplacing<float> context(block);
+                convolution.process(context);
+            }
+            else
+            {
+                for (int ch = 0; ch < NumChannels; ++ch)
+                {
+                    auto* converted = conversionBuffer.getWritePointer(ch);
+                    for (int i = 0; i < length; ++i)
+                        converted[i] = static_cast<float>(channels[ch][start + i]);
+                }
+
+                juce::dsp::AudioBlock<float> block(conversionBuffer.getArrayOfWritePointers(), NumChannels,
+                                                   static_cast<size_t>(length));
+                juce::dsp::ProcessContextReplacing<float> context(block);
+                convolution.process(context);
+
+                for (int ch = 0; ch < NumChannels; ++ch)
+                {
+                    const auto* converted = conversionBuffer.getReadPointer(ch);
+                    for (int i = 0; i < length; ++i)
+                        channels[ch][start + i] = static_cast<SampleType>(converted[i]);
+                }
+            }
+        }
+    }
+
+    int LinearPhaseEQ::useTimeSlice()
+    {
+        const juce::ScopedLock sl(designLock);
+
+        if (fft == nullptr || pendingVersion.load() == designedVersion)
+            return designIntervalMs;
+
+        Response response;
+
+        {
+            const juce::SpinLock::ScopedLockType lock(pendingLock);
+            response = pending;
+            designedVersion = pendingVersion.load();
+        }
+
+        // The convolution builds its partitions on its own background queue and
+        // crossfades from the current filter once they are ready
+        convolution.loadImpulseResponse(designFilter(response), sampleRate,
+                                        juce::dsp::Convolution::Stereo::yes,
+                                        juce::dsp::Convolution::Trim::no,
+                                        juce::dsp::Convolution::Normalise::no);
+
+        return designIntervalMs;
+    }
+
+    juce::AudioBuffer<float> LinearPhaseEQ::designFilter(const Response& response)
+    {
+        const int length = filterLength;
+        const int half = length / 2;
+        const double pi = juce::MathConstants<double>::pi;
+
+        juce::AudioBuffer<float> filter(NumChannels, length);
+
+        for (int ch = 0; ch < NumChannels; ++ch)
+        {
+            // Frequency sampling: the magnitude with a delay of half the length, which
+            // alternates the sign of every other bin
+            std::fill(spectrum.get(), spectrum.get() + length * 2, 0.0f);
+
+            for (int k = 0; k <= half; ++k)
+            {
+                const auto z1 = std::polar(1.0, -2.0 * pi * k / length);
+                double magnitude = 1.0;
+
+                for (const auto& section : response.sections[ch])
+                    magnitude *= std::abs(sectionResponse(section, z1));
+
+                spectrum[2 * k] = static_cast<float>((k & 1) != 0 ? -magnitude : magnitude);
+            }
+
+            fft->performRealOnlyInverseTransform(spectrum.get());
+
+            // Periodic Hann taper centred on the peak keeps the impulse symmetric
+            auto* data = filter.getWritePointer(ch);
+
+            for (int i = 0; i < length; ++i)
+                data[i] = spectrum[i] * static_cast<float>(0.5 - 0.5 * std::cos(2.0 * pi * i / length));
+        }
+
+        return filter;
+    }
+
+    template void LinearPhaseEQ::process<float>(float*, float*, int);
+    template void LinearPhaseEQ::process<double>(double*, double*, int);
+}
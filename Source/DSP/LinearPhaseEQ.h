@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    LinearPhaseEQ - FIR Rendition of the EQ Curve via Partitioned Convolution
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <juce_core/juce_core.h>
+#include "BiquadCoefficients.h"
+
+namespace Aetheri
+{
+    /**
+     * Linear-phase version of the combined band + HPF/LPF magnitude response
+     * The audio thread hands over the settled section designs; a shared background
+     * thread samples their magnitude, builds a symmetric FIR and loads it into a
+     * non-uniform partitioned convolution (short zero-latency head, long FFT tail),
+     * which crossfades from the previous filter. Latency is half the FIR length.
+     */
+    class LinearPhaseEQ : public juce::TimeSliceClient
+    {
+    public:
+        static constexpr int NumChannels = 2;
+        static constexpr int NumSections = 6;   // Four bands, HPF, LPF
+
+        // Section designs per channel; unused sections stay at unity
+        struct Response
+        {
+            std::array<std::array<BiquadCoefficients, NumSections>, NumChannels> sections {};
+
+            bool operator==(const Response& other) const;
+            bool operator!=(const Response& other) const { return !(*this == other); }
+        };
+
+        LinearPhaseEQ();
+        ~LinearPhaseEQ() override;
+
+        // Not on the audio thread
+        void prepare(double sampleRate, int samplesPerBlock);
+        void reset();
+
+        // FIR length for a sample rate, so the latency can be reported before prepare
+        static int getFilterLength(double sampleRate);
+        int getLatencySamples() const { return filterLength / 2; }
+
+        // Audio thread: never blocks - a handover that finds the worker busy is retried next block
+        void setResponse(const Response& response);
+
+        // The convolution runs in 32-bit; 64-bit blocks are converted around it
+        template <typename SampleType>
+        void process(SampleType* left, SampleType* right, int numSamples);
+
+        // Design thread
+        int useTimeSlice() override;
+
+    private:
+        struct DesignThread;
+        juce::SharedResourcePointer<DesignThread> designThread;
+
+        static constexpr int headSize = 256;
+
+        juce::dsp::Convolution convolution { juce::dsp::Convolution::NonUniform { headSize } };
+        double sampleRate = 44100.0;
+        int filterLength = 0;
+        int maxBlockSize = 0;
+        juce::AudioBuffer<float> conversionBuffer;
+
+        // Audio thread -> design thread
+        juce::SpinLock pendingLock;
+        Response pending;
+        std::atomic<juce::uint32> pendingVersion { 0 };
+        Response lastRequested;
+        bool hasRequested = false;
+
+        // Design thread state (prepare also takes the lock)
+        juce::CriticalSection designLock;
+        juce::uint32 designedVersion = 0;
+        std::unique_ptr<juce::dsp::FFT> fft;
+        juce::HeapBlock<float> spectrum;
+
+        juce::AudioBuffer<float> designFilter(const Response& response);
+    };
+}
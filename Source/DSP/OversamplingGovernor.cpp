@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    OversamplingGovernor Implementation
+  ==============================================================================
+*/
+
+#include "OversamplingGovernor.h"
+#include <cmath>
+
+namespace Aetheri
+{
+    namespace
+    {
+        // Internal drive ranges of the hysteresis stage at 100%
+        constexpr float tubeScale = 0.7f;
+        constexpr float transformerScale = 0.6f;
+
+        // Curve breakpoints of softClipOdd / softClipEven
+        constexpr float tubeCubicLimit = 0.5f;
+        constexpr float transformerKnee = 0.3f;
+        constexpr float transformerHardKnee = 0.8f;
+
+        // Harmonics below this are left to alias
+        constexpr float harmonicFloor = 3.16e-5f;  // -90 dBFS
+
+        // Peaks standing more than 12 dB above the RMS are too brief for their aliases to matter
+        constexpr float maxCrestFactor = 4.0f;
+
+        constexpr double peakReleaseSeconds = 0.5;
+        constexpr double rmsSeconds = 0.3;
+        constexpr double holdSeconds = 3.0;
+        constexpr float stepDownMargin = 2.0f;  // +6 dB
+
+        constexpr float audibleLimit = 20000.0f;
+        constexpr int maxFactor = 16;
+
+        int getHarmonicOrder(OversamplingGovernor::Reason reason)
+        {
+            switch (reason)
+            {
+                case OversamplingGovernor::Reason::GentleCurve:     return 3;
+                case OversamplingGovernor::Reason::SoftKnee:        return 5;
+                case OversamplingGovernor::Reason::HardSaturation:  return 7;
+                default:                                            return 1;
+            }
+        }
+    }
+
+    void OversamplingGovernor::prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+    }
+
+    void OversamplingGovernor::reset(const Settings& settings)
+    {
+        peakEnvelope = 1.0f;
+        meanSquareEnvelope = 0.5f;
+        holdSamples = 0;
+        holdFactor = 1;
+        holdReason = Reason::SaturationOff;
+
+        const auto demand = classify(settings, 1.0f);
+        ceiling = getRequiredFactor(demand);
+        setDecision(ceiling, demand);
+    }
+
+    juce::String OversamplingGovernor::getReasonText(Reason reason)
+    {
+        switch (reason)
+        {
+            case Reason::SaturationOff:   return "saturation off";
+            case Reason::LinearRegion:    return "level below the saturation curves";
+            case Reason::GentleCurve:     return "gentle tube curve (3rd harmonic)";
+            case Reason::SoftKnee:        return "transformer knee (up to the 5th harmonic)";
+            case Reason::HardSaturation:  return "hard saturation (up to the 7th harmonic)";
+        }
+
+        return {};
+    }
+
+    OversamplingGovernor::Reason OversamplingGovernor::classify(const Settings& settings, float level) const
+    {
+        const float tube = settings.tube * tubeScale;
+        const float transformer = settings.transformer * transformerScale;
+
+        if (!settings.enabled || settings.mix <= 0.0f || (tube < 0.001f && transformer < 0.001f))
+            return Reason::SaturationOff;
+
+        auto demand = Reason::LinearRegion;
+
+        if (tube >= 0.001f)
+        {
+            // The high-frequency emphasis can push the curve input up to (1 + amount) times the level
+            const float drive = level * (1.0f + tube);
+
+            if (drive >= tubeCubicLimit)
+                demand = Reason::HardSaturation;
+            else if (0.075f * tube * settings.mix * drive * drive * drive > harmonicFloor)
+                demand = Reason::GentleCurve;
+        }
+
+        if (transformer >= 0.001f && demand != Reason::HardSaturation)
+        {
+            const float drive = level * (1.0f + 0.5f * transformer);
+
+            if (drive >= transformerHardKnee)
+                demand = Reason::HardSaturation;
+            else if (drive >= transformerKnee)
+                demand = Reason::SoftKnee;
+        }
+
+        return demand;
+    }
+
+    int OversamplingGovernor::getRequiredFactor(Reason demand) const
+    {
+        // The alias of harmonic K lands at F*fs - K*f; keep it above the band we care about
+        const float fs = static_cast<float>(sampleRate);
+        const float highest = std::min(audibleLimit, 0.45f * fs);
+        const float required = static_cast<float>(getHarmonicOrder(demand) + 1) * highest;
+
+        int newFactor = 1;
+
+        while (newFactor < maxFactor && static_cast<float>(newFactor) * fs < required)
+            newFactor *= 2;
+
+        return newFactor;
+    }
+
+    void OversamplingGovernor::setDecision(int newFactor, Reason newReason)
+    {
+        factor.store(newFactor, std::memory_order_relaxed);
+        reason.store(static_cast<int>(newReason), std::memory_order_relaxed);
+    }
+
+    template <typename SampleType>
+    void OversamplingGovernor::process(const juce::dsp::AudioBlock<SampleType>& block, const Settings& settings)
+    {
+        const auto numChannels = block.getNumChannels();
+        const int numSamples = static_cast<int>(block.getNumSamples());
+
+        if (numSamples == 0)
+            return;
+
+        // Block peak and mean square over all channels
+        SampleType blockPeak = 0;
+        double sumOfSquares = 0.0;
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            const auto* data = block.getChannelPointer(channel);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                blockPeak = std::max(blockPeak, std::abs(data[i]));
+                sumOfSquares += static_cast<double>(data[i]) * static_cast<double>(data[i]);
+            }
+        }
+
+        const double meanSquare = sumOfSquares / static_cast<double>(numSamples * static_cast<int>(std::max<size_t>(numChannels, 1)));
+
+        // Instant attack, slow release on the peak; one-pole average on the power
+        const float peakRelease = static_cast<float>(std::exp(-numSamples / (peakReleaseSeconds * sampleRate)));
+        const float rmsDecay = static_cast<float>(std::exp(-numSamples / (rmsSeconds * sampleRate)));
+        peakEnvelope = std::max(static_cast<float>(blockPeak), peakEnvelope * peakRelease);
+        meanSquareEnvelope = static_cast<float>(meanSquare) + (meanSquareEnvelope - static_cast<float>(meanSquare)) * rmsDecay;
+
+        const float level = std::min(peakEnvelope, std::sqrt(meanSquareEnvelope) * maxCrestFactor);
+
+        // New settings start again from their full-scale factor
+        const auto fullScaleDemand = classify(settings, 1.0f);
+        const int fullScaleFactor = getRequiredFactor(fullScaleDemand);
+
+        if (fullScaleFactor != ceiling)
+        {
+            ceiling = fullScaleFactor;
+            holdSamples = 0;
+            setDecision(ceiling, fullScaleDemand);
+            return;
+        }
+
+        // A louder passage than the factor was lowered for waits for the next reset()
+        const int current = getFactor();
+        const auto demand = classify(settings, level);
+        const int required = getRequiredFactor(demand);
+
+        // Down only once the lower factor has held, with margin, for the whole hold time
+        const auto marginDemand = classify(settings, level * stepDownMargin);
+        const int marginFactor = getRequiredFactor(marginDemand);
+
+        if (marginFactor >= current)
+        {
+            holdSamples = 0;
+
+            // Same factor, but keep the reason in step with the signal
+            if (required == current)
+                setDecision(current, demand);
+
+            return;
+        }
+
+        if (holdSamples == 0 || marginFactor > holdFactor)
+        {
+            holdFactor = marginFactor;
+            holdReason = marginDemand;
+        }
+
+        holdSamples += numSamples;
+
+        if (holdSamples >= static_cast<int>(holdSeconds * sampleRate))
+        {
+            holdSamples = 0;
+            setDecision(holdFactor, holdReason);
+        }
+    }
+
+    template void OversamplingGovernor::process<float>(const juce::dsp::AudioBlock<float>&, const Settings&);
+    template void OversamplingGovernor::process<double>(const juce::dsp::AudioBlock<double>&, const Settings&);
+}
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    OversamplingGovernor - Automatic Oversampling Factor for the Saturation Stage
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <juce_core/juce_core.h>
+#include <atomic>
+
+namespace Aetheri
+{
+    /**
+     * Picks the lowest oversampling factor that keeps the saturation's aliasing out of the
+     * audible band
+     * The highest significant harmonic follows from the hysteresis settings and the level
+     * reaching the curves; the factor has to lift the oversampled Nyquist above it far
+     * enough that its alias folds back beyond 20 kHz. Every switch fades the output, so
+     * the factor starts from what the settings need at full scale, and the measured level
+     * only ever lowers it - once the lower factor has held with 6 dB to spare for a few
+     * seconds. A transient never switches up mid-playback; reset() at the next silent point
+     * goes back to the full-scale factor. A settings change moves it there at once, like
+     * picking a factor by hand
+     */
+    class OversamplingGovernor
+    {
+    public:
+        // Why the current factor was chosen (for display)
+        enum class Reason
+        {
+            SaturationOff = 0,  // Hysteresis disabled, dry or without drive
+            LinearRegion,       // Signal stays below the curves; harmonics under -90 dBFS
+            GentleCurve,        // Cubic region of the tube curve (3rd harmonic)
+            SoftKnee,           // Transformer knee (up to the 5th)
+            HardSaturation      // tanh limiting (up to the 7th)
+        };
+
+        struct Settings
+        {
+            bool enabled = false;
+            float tube = 0.0f;         // 0-1
+            float transformer = 0.0f;  // 0-1
+            float mix = 1.0f;          // 0-1
+        };
+
+        OversamplingGovernor() = default;
+
+        void prepare(double sampleRate);
+
+        // Starts from the factor the settings need at full scale, before any level is known
+        void reset(const Settings& settings);
+
+        // Audio thread: measures the block entering the saturation stage and lowers the factor
+        // if the level has allowed it for long enough
+        template <typename SampleType>
+        void process(const juce::dsp::AudioBlock<SampleType>& block, const Settings& settings);
+
+        // Safe from any thread
+        int getFactor() const { return factor.load(std::memory_order_relaxed); }
+        Reason getReason() const { return static_cast<Reason>(reason.load(std::memory_order_relaxed)); }
+        static juce::String getReasonText(Reason reason);
+
+    private:
+        double sampleRate = 44100.0;
+
+        // Level envelopes of the saturation input
+        float peakEnvelope = 0.0f;
+        float meanSquareEnvelope = 0.0f;
+
+        // Factor the settings need at full scale; the level can only go below it
+        int ceiling = 1;
+
+        // Pending step down: time the lower demand has held and the highest factor it asked for
+        int holdSamples = 0;
+        int holdFactor = 1;
+        Reason holdReason = Reason::SaturationOff;
+
+        std::atomic<int> factor { 1 };
+        std::atomic<int> reason { 0 };
+
+        Reason classify(const Settings& settings, float level) const;
+        int getRequiredFactor(Reason demand) const;
+        void setDecision(int newFactor, Reason newReason);
+    };
+}
@@ -0,0 +1,498 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    ParallelBiquadKernel Implementation
+  ==============================================================================
+*/
+
+#include "ParallelBiquadKernel.h"
+
+namespace Aetheri
+{
+    namespace
+    {
+       #if JUCE_USE_SIMD
+        using DoublePair = juce::dsp::SIMDRegister<double>;
+       #else
+        // Scalar stand-in with the subset of the SIMDRegister interface used below
+        struct DoublePair
+        {
+            static constexpr size_t SIMDNumElements = 2;
+            double v[2];
+
+            static DoublePair expand(double s) noexcept                 { return { { s, s } }; }
+            static DoublePair fromRawArray(const double* a) noexcept    { return { { a[0], a[1] } }; }
+            void copyToRawArray(double* a) const noexcept               { a[0] = v[0]; a[1] = v[1]; }
+            static DoublePair abs(DoublePair a) noexcept                { return { { std::abs(a.v[0]), std::abs(a.v[1]) } }; }
+            double sum() const noexcept                                 { return v[0] + v[1]; }
+
+            DoublePair operator+(DoublePair o) const noexcept { return { { v[0] + o.v[0], v[1] + o.v[1] } }; }
+            DoublePair operator-(DoublePair o) const noexcept { return { { v[0] - o.v[0], v[1] - o.v[1] } }; }
+            DoublePair operator*(DoublePair o) const noexcept { return { { v[0] * o.v[0], v[1] * o.v[1] } }; }
+        };
+       #endif
+
+        static_assert(ParallelBiquadKernel::NumSections == 2 * DoublePair::SIMDNumElements,
+                      "ParallelBiquadKernel expects two sections per 64-bit SIMD register");
+
+        // Acceptance limits for a decomposition
+        constexpr double responseTolerance = 1.0e-8;
+        constexpr double maxResidueSum = 1.0e6;
+
+        using Complex = std::complex<double>;
+
+        // Section response at w = z^-1
+        Complex sectionResponse(const BiquadCoefficients& c, Complex w)
+        {
+            return (c.b0 + w * (c.b1 + w * c.b2)) / (1.0 + w * (c.a1 + w * c.a2));
+        }
+
+        // Roots of z^2 + a1 z + a2, computed without cancellation
+        void sectionPoles(const BiquadCoefficients& c, Complex& p1, Complex& p2)
+        {
+            auto root = std::sqrt(Complex(c.a1 * c.a1 - 4.0 * c.a2, 0.0));
+            auto q = -0.5 * (c.a1 + (c.a1 >= 0.0 ? root : -root));
+            p1 = q;
+            p2 = c.a2 / q;
+        }
+
+        // z^-1 at each pole of a section; returns the section's order
+        int sectionInversePoles(const BiquadCoefficients& c, Complex (&w)[2])
+        {
+            if (c.a2 != 0.0)
+            {
+                Complex p1, p2;
+                sectionPoles(c, p1, p2);
+                w[0] = 1.0 / p1;
+                w[1] = 1.0 / p2;
+                return 2;
+            }
+
+            if (c.a1 != 0.0)
+            {
+                w[0] = -1.0 / c.a1;
+                return 1;
+            }
+
+            return 0;
+        }
+
+        // Response at w to band k's stored state (numerator s1 + s2 w) through the rest of the
+        // cascade, with section m's denominator taken out (m >= k)
+        Complex stateResponse(const ParallelBiquadKernel::Cascade& cascade, int k, int m, Complex stateNumerator, Complex w)
+        {
+            auto value = stateNumerator;
+
+            for (int j = k; j < ParallelBiquadKernel::NumSections; ++j)
+            {
+                const auto& c = cascade[static_cast<size_t>(j)];
+
+                if (j > k)
+                    value *= c.b0 + w * (c.b1 + w * c.b2);
+                if (j != m)
+                    value /= 1.0 + w * (c.a1 + w * c.a2);
+            }
+
+            return value;
+        }
+
+        Complex stateNumerator(const SectionState& state, Complex w)
+        {
+            return state.s1 + state.s2 * w;
+        }
+
+        // The numerator s1 + s2 w through its values at a section's poles
+        bool fitStateNumerator(int order, const Complex (&w)[2], const Complex (&values)[2], double limit, SectionState& result)
+        {
+            result = {};
+
+            if (order == 1)
+            {
+                result.s1 = values[0].real();
+            }
+            else if (order == 2)
+            {
+                const auto spread = w[0] - w[1];
+
+                if (std::abs(spread) < 1.0e-12)
+                    return false;
+
+                const auto slope = (values[0] - values[1]) / spread;
+                result.s1 = (values[0] - slope * w[0]).real();
+                result.s2 = slope.real();
+            }
+
+            // Coincident poles across sections blow the values up, as they do the residues
+            return std::abs(result.s1) + std::abs(result.s2) < limit;
+        }
+
+        double getStateLimit(const ParallelBiquadKernel::SectionStates& states)
+        {
+            double sum = 1.0;
+
+            for (const auto& state : states)
+                sum += std::abs(state.s1) + std::abs(state.s2);
+
+            return sum * maxResidueSum;
+        }
+    }
+
+    //==============================================================================
+    bool ParallelBiquadKernel::decompose(const Cascade& cascade, ParallelForm& result)
+    {
+        ParallelForm form;
+        Complex poles[NumSections][2];
+        int sectionOrder[NumSections] {};
+
+        // Direct term: the response as z^-1 goes to infinity
+        for (int k = 0; k < NumSections; ++k)
+        {
+            const auto& c = cascade[static_cast<size_t>(k)];
+
+            if (c.a1 == 0.0 && c.a2 == 0.0)
+            {
+                // A pole-free section has to be a plain pass-through to fit the parallel form
+                if (!c.isUnity())
+                    return false;
+
+                continue;
+            }
+
+            if (c.a2 != 0.0)
+            {
+                sectionOrder[k] = 2;
+                sectionPoles(c, poles[k][0], poles[k][1]);
+                form.direct *= c.b2 / c.a2;
+            }
+            else
+            {
+                if (c.b2 != 0.0)
+                    return false;
+
+                sectionOrder[k] = 1;
+                poles[k][0] = -c.a1;
+                form.direct *= c.b1 / c.a1;
+            }
+
+            form.a1[k] = c.a1;
+            form.a2[k] = c.a2;
+        }
+
+        // Residue of each pole: the response with that pole's factor removed, taken at the pole
+        double residueSum = 0.0;
+
+        for (int k = 0; k < NumSections; ++k)
+        {
+            if (sectionOrder[k] == 0)
+                continue;
+
+            const auto& c = cascade[static_cast<size_t>(k)];
+            Complex residues[2];
+
+            for (int i = 0; i < sectionOrder[k]; ++i)
+            {
+                const auto w = 1.0 / poles[k][i];
+                auto value = c.b0 + w * (c.b1 + w * c.b2);
+
+                if (sectionOrder[k] == 2)
+                    value /= 1.0 - poles[k][1 - i] * w;
+
+                for (int j = 0; j < NumSections; ++j)
+                    if (j != k)
+                        value *= sectionResponse(cascade[static_cast<size_t>(j)], w);
+
+                residues[i] = value;
+            }
+
+            // Conjugate (or real) pole pairs recombine into one real second-order section
+            if (sectionOrder[k] == 2)
+            {
+                form.beta0[k] = (residues[0] + residues[1]).real();
+                form.beta1[k] = -(residues[0] * poles[k][1] + residues[1] * poles[k][0]).real();
+            }
+            else
+            {
+                form.beta0[k] = residues[0].real();
+            }
+
+            residueSum += std::abs(form.beta0[k]) + std::abs(form.beta1[k]);
+        }
+
+        // Coincident poles show up as huge or non-finite residues
+        if (!(residueSum < maxResidueSum) || !std::isfinite(form.direct))
+            return false;
+
+        // The split has to reproduce the cascade's magnitude and phase across the band
+        for (double omega : { 0.0, 0.0001, 0.0003, 0.001, 0.003, 0.01, 0.03, 0.1, 0.3, 1.0, 2.0, 3.0, juce::MathConstants<double>::pi })
+        {
+            auto expected = evaluate(cascade, omega);
+
+            if (std::abs(evaluate(form, omega) - expected) > responseTolerance * (1.0 + std::abs(expected)))
+                return false;
+        }
+
+        result = form;
+        return true;
+    }
+
+    std::complex<double> ParallelBiquadKernel::evaluate(const Cascade& cascade, double omega)
+    {
+        const auto w = std::polar(1.0, -omega);
+        const auto w2 = w * w;
+        std::complex<double> response { 1.0, 0.0 };
+
+        for (const auto& c : cascade)
+            response *= (c.b0 + c.b1 * w + c.b2 * w2) / (1.0 + c.a1 * w + c.a2 * w2);
+
+        return response;
+    }
+
+    std::complex<double> ParallelBiquadKernel::evaluate(const ParallelForm& form, double omega)
+    {
+        const auto w = std::polar(1.0, -omega);
+        const auto w2 = w * w;
+        std::complex<double> response { form.direct, 0.0 };
+
+        for (int k = 0; k < NumSections; ++k)
+            response += (form.beta0[k] + form.beta1[k] * w) / (1.0 + form.a1[k] * w + form.a2[k] * w2);
+
+        return response;
+    }
+
+    bool ParallelBiquadKernel::toParallelStates(const Cascade& cascade, const SectionStates& bandStates, SectionStates& result)
+    {
+        // The response to the stored state splits into one term per pole pair: evaluated at
+        // section m's poles, only the bands up to m contribute to it
+        const double limit = getStateLimit(bandStates);
+
+        for (int m = 0; m < NumSections; ++m)
+        {
+            Complex w[2], values[2];
+            const int order = sectionInversePoles(cascade[static_cast<size_t>(m)], w);
+
+            for (int i = 0; i < order; ++i)
+                for (int k = 0; k <= m; ++k)
+                    values[i] += stateResponse(cascade, k, m, stateNumerator(bandStates[static_cast<size_t>(k)], w[i]), w[i]);
+
+            if (!fitStateNumerator(order, w, values, limit, result[static_cast<size_t>(m)]))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ParallelBiquadKernel::toCascadeStates(const Cascade& cascade, const SectionStates& sectionStates, SectionStates& result)
+    {
+        // The same split read the other way, band by band: at band m's poles the earlier
+        // bands' share is known, and band m's own state passes through the bands after it
+        const double limit = getStateLimit(sectionStates);
+
+        for (int m = 0; m < NumSections; ++m)
+        {
+            Complex w[2], values[2];
+            const int order = sectionInversePoles(cascade[static_cast<size_t>(m)], w);
+
+            for (int i = 0; i < order; ++i)
+            {
+                values[i] = stateNumerator(sectionStates[static_cast<size_t>(m)], w[i]);
+
+                for (int k = 0; k < m; ++k)
+                    values[i] -= stateResponse(cascade, k, m, stateNumerator(result[static_cast<size_t>(k)], w[i]), w[i]);
+
+                const auto throughGain = stateResponse(cascade, m, m, 1.0, w[i]);
+
+                if (!(std::abs(throughGain) > 1.0e-9))
+                    return false;
+
+                values[i] /= throughGain;
+            }
+
+            if (!fitStateNumerator(order, w, values, limit, result[static_cast<size_t>(m)]))
+                return false;
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    ParallelBiquadKernel::Coefficients ParallelBiquadKernel::makeIdentity()
+    {
+        Coefficients identity {};
+
+        for (int lane = 0; lane < NumLanes; ++lane)
+            identity.direct[lane] = 1.0;
+
+        return identity;
+    }
+
+    void ParallelBiquadKernel::reset()
+    {
+        state = {};
+    }
+
+    void ParallelBiquadKernel::store(Coefficients& dest, int lane, const ParallelForm& form) const
+    {
+        dest.direct[lane] = form.direct;
+
+        for (int k = 0; k < NumSections; ++k)
+        {
+            dest.beta0[lane][k] = form.beta0[k];
+            dest.beta1[lane][k] = form.beta1[k];
+            // Stored negated so the kernel only needs multiply-adds
+            dest.a1[lane][k] = -form.a1[k];
+            dest.a2[lane][k] = -form.a2[k];
+        }
+    }
+
+    ParallelBiquadKernel::SectionStates ParallelBiquadKernel::getSectionStates(int lane) const
+    {
+        SectionStates states;
+
+        for (int k = 0; k < NumSections; ++k)
+            states[static_cast<size_t>(k)] = { state.s1[lane][k], state.s2[lane][k] };
+
+        return states;
+    }
+
+    void ParallelBiquadKernel::setSectionStates(int lane, const SectionStates& states)
+    {
+        // The sections already run in transposed direct form II
+        for (int k = 0; k < NumSections; ++k)
+        {
+            state.s1[lane][k] = states[static_cast<size_t>(k)].s1;
+            state.s2[lane][k] = states[static_cast<size_t>(k)].s2;
+        }
+    }
+
+    bool ParallelBiquadKernel::setCascade(int lane, const Cascade& cascade, int numSamples)
+    {
+        jassert(lane >= 0 && lane < NumLanes);
+
+        ParallelForm form;
+        if (!decompose(cascade, form))
+            return false;
+
+        store(targets, lane, form);
+
+        // Section layout follows the bands, so the same section glides between designs
+        const double scale = numSamples > 1 ? 1.0 / numSamples : 0.0;
+        bool moves = false;
+
+        auto glide = [&] (double (&current)[NumLanes][NumSections], const double (&target)[NumLanes][NumSections],
+                          double (&delta)[NumLanes][NumSections])
+        {
+            for (int k = 0; k < NumSections; ++k)
+            {
+                if (numSamples <= 1)
+                    current[lane][k] = target[lane][k];
+
+                delta[lane][k] = (target[lane][k] - current[lane][k]) * scale;
+                moves = moves || delta[lane][k] != 0.0;
+            }
+        };
+
+        glide(coeffs.beta0, targets.beta0, deltas.beta0);
+        glide(coeffs.beta1, targets.beta1, deltas.beta1);
+        glide(coeffs.a1, targets.a1, deltas.a1);
+        glide(coeffs.a2, targets.a2, deltas.a2);
+
+        if (numSamples <= 1)
+            coeffs.direct[lane] = targets.direct[lane];
+
+        deltas.direct[lane] = (targets.direct[lane] - coeffs.direct[lane]) * scale;
+        moves = moves || deltas.direct[lane] != 0.0;
+
+        ramping = ramping || moves;
+        return true;
+    }
+
+    template <typename SampleType>
+    void ParallelBiquadKernel::processBlock(SampleType* left, SampleType* right, int numSamples)
+    {
+        // Registers [lane][half]: half 0 = sections 0-1, half 1 = sections 2-3
+        DoublePair b0[NumLanes][2], b1[NumLanes][2], na1[NumLanes][2], na2[NumLanes][2];
+        DoublePair db0[NumLanes][2], db1[NumLanes][2], dna1[NumLanes][2], dna2[NumLanes][2];
+        DoublePair s1[NumLanes][2], s2[NumLanes][2];
+        double direct[NumLanes], dDirect[NumLanes];
+
+        for (int lane = 0; lane < NumLanes; ++lane)
+        {
+            direct[lane] = coeffs.direct[lane];
+            dDirect[lane] = deltas.direct[lane];
+
+            for (int half = 0; half < 2; ++half)
+            {
+                const int k = half * 2;
+                b0[lane][half] = DoublePair::fromRawArray(&coeffs.beta0[lane][k]);
+                b1[lane][half] = DoublePair::fromRawArray(&coeffs.beta1[lane][k]);
+                na1[lane][half] = DoublePair::fromRawArray(&coeffs.a1[lane][k]);
+                na2[lane][half] = DoublePair::fromRawArray(&coeffs.a2[lane][k]);
+                db0[lane][half] = DoublePair::fromRawArray(&deltas.beta0[lane][k]);
+                db1[lane][half] = DoublePair::fromRawArray(&deltas.beta1[lane][k]);
+                dna1[lane][half] = DoublePair::fromRawArray(&deltas.a1[lane][k]);
+                dna2[lane][half] = DoublePair::fromRawArray(&deltas.a2[lane][k]);
+                s1[lane][half] = DoublePair::fromRawArray(&state.s1[lane][k]);
+                s2[lane][half] = DoublePair::fromRawArray(&state.s2[lane][k]);
+            }
+        }
+
+        const bool glide = ramping;
+        SampleType* channels[NumLanes] = { left, right };
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane)
+            {
+                if (glide)
+                {
+                    direct[lane] += dDirect[lane];
+
+                    for (int half = 0; half < 2; ++half)
+                    {
+                        b0[lane][half] = b0[lane][half] + db0[lane][half];
+                        b1[lane][half] = b1[lane][half] + db1[lane][half];
+                        na1[lane][half] = na1[lane][half] + dna1[lane][half];
+                        na2[lane][half] = na2[lane][half] + dna2[lane][half];
+                    }
+                }
+
+                const double input = static_cast<double>(channels[lane][i]);
+                const auto x = DoublePair::expand(input);
+
+                // All four sections at once - none depends on another
+                DoublePair y[2];
+
+                for (int half = 0; half < 2; ++half)
+                {
+                    y[half] = b0[lane][half] * x + s1[lane][half];
+                    s1[lane][half] = b1[lane][half] * x + na1[lane][half] * y[half] + s2[lane][half];
+                    s2[lane][half] = na2[lane][half] * y[half];
+                }
+
+                const double output = direct[lane] * input + (y[0] + y[1]).sum();
+                channels[lane][i] = static_cast<SampleType>(output);
+            }
+        }
+
+        for (int lane = 0; lane < NumLanes; ++lane)
+        {
+            for (int half = 0; half < 2; ++half)
+            {
+                const int k = half * 2;
+                s1[lane][half].copyToRawArray(&state.s1[lane][k]);
+                s2[lane][half].copyToRawArray(&state.s2[lane][k]);
+            }
+        }
+
+        // Land exactly on the decomposed coefficients rather than the accumulated sum
+        if (glide)
+        {
+            coeffs = targets;
+            deltas = {};
+            ramping = false;
+        }
+    }
+
+    template void ParallelBiquadKernel::processBlock<float>(float*, float*, int);
+    template void ParallelBiquadKernel::processBlock<double>(double*, double*, int);
+}
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    ParallelBiquadKernel - Partial-Fraction (Parallel Form) EQ Kernel (64-bit, SIMD)
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <juce_core/juce_core.h>
+#include "BiquadCoefficients.h"
+
+namespace Aetheri
+{
+    /**
+     * Four-band EQ evaluated as a direct term plus four second-order sections in parallel
+     * The series cascade is split by partial fractions whenever its coefficients change,
+     * so every section only depends on the input and the four sections run side by side
+     * in two double x2 SIMD registers per channel instead of waiting on each other
+     */
+    class ParallelBiquadKernel
+    {
+    public:
+        static constexpr int NumSections = 4;
+        static constexpr int NumLanes = 2;
+
+        using Cascade = std::array<BiquadCoefficients, NumSections>;
+
+        /**
+         * H(z) = direct + sum_k (beta0[k] + beta1[k] z^-1) / (1 + a1[k] z^-1 + a2[k] z^-2)
+         * Section k carries the poles of cascade section k (all zero for a pole-free section)
+         */
+        struct ParallelForm
+        {
+            double direct = 1.0;
+            double beta0[NumSections] {}, beta1[NumSections] {};
+            double a1[NumSections] {}, a2[NumSections] {};
+        };
+
+        ParallelBiquadKernel() = default;
+
+        void reset();
+
+        /**
+         * Splits a series cascade into parallel form; returns false when that can't be done
+         * to within float accuracy (coincident or badly conditioned poles, FIR-only sections)
+         */
+        static bool decompose(const Cascade& cascade, ParallelForm& result);
+
+        // Complex response of either form at normalised angular frequency omega
+        static std::complex<double> evaluate(const Cascade& cascade, double omega);
+        static std::complex<double> evaluate(const ParallelForm& form, double omega);
+
+        // Lane 0 = L/M, lane 1 = R/S; glides linearly over the next processBlock of numSamples
+        bool setCascade(int lane, const Cascade& cascade, int numSamples);
+
+        using SectionStates = std::array<SectionState, NumSections>;
+
+        /**
+         * State of the series cascade's bands re-expressed for the parallel sections of the
+         * same filter and back, by splitting the response to the stored state by partial
+         * fractions like the filter itself. Both return false where decompose() would
+         */
+        static bool toParallelStates(const Cascade& cascade, const SectionStates& bandStates, SectionStates& result);
+        static bool toCascadeStates(const Cascade& cascade, const SectionStates& sectionStates, SectionStates& result);
+
+        // The sections' own state (lane 0 = L/M, lane 1 = R/S) for handing over to another engine
+        SectionStates getSectionStates(int lane) const;
+        void setSectionStates(int lane, const SectionStates& states);
+
+        template <typename SampleType>
+        void processBlock(SampleType* left, SampleType* right, int numSamples);
+
+    private:
+        // [lane][section]: sections 0-1 and 2-3 each fill one SIMD register
+        struct alignas(64) Coefficients
+        {
+            alignas(16) double beta0[NumLanes][NumSections];
+            alignas(16) double beta1[NumLanes][NumSections];
+            alignas(16) double a1[NumLanes][NumSections];
+            alignas(16) double a2[NumLanes][NumSections];
+            double direct[NumLanes];
+        };
+
+        // Transposed Direct Form II per section
+        struct alignas(64) State
+        {
+            alignas(16) double s1[NumLanes][NumSections];
+            alignas(16) double s2[NumLanes][NumSections];
+        };
+
+        Coefficients coeffs = makeIdentity();
+        Coefficients targets = makeIdentity();
+        Coefficients deltas {};
+        State state {};
+        bool ramping = false;
+
+        static Coefficients makeIdentity();
+        void store(Coefficients& dest, int lane, const ParallelForm& form) const;
+    };
+}
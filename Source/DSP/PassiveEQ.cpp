@@ -13,15 +13,16 @@ namespace Aetheri
     // EQBand Implementation
     //==============================================================================
     
-    void EQBand::prepare(double newSampleRate, int /*samplesPerBlock*/)
+    void EQBand::prepare(double sampleRate, int /*samplesPerBlock*/)
     {
-        sampleRate = newSampleRate;
-        smoothedGain.reset(sampleRate, 0.05);  // 50ms smoothing
-        smoothedFreq.reset(sampleRate, 0.05);
+        glide.setLength(juce::roundToInt(sampleRate * 0.05));  // 50ms glide
         reset();
-        // Initialize coefficients to unity (bypass) state
-        needsUpdate = true;
-        updateCoefficients();
+        // Unity (bypass) until the first design for this rate arrives
+        glide.setImmediate({});
+        coeffRamp.setImmediate({});
+        targetInitialised = false;
+        snapPending = false;
+        samplesUntilControlUpdate = 0;
     }
     
     void EQBand::reset()
@@ -32,113 +33,73 @@ namespace Aetheri
     void EQBand::setParameters(float frequency, float gainDB, float q, CurveType curve, bool enabled)
     {
         bandEnabled = enabled;
+        currentFreq = frequency;
+        currentGainDB = gainDB;
         currentQ = q;
         currentCurve = curve;
-        
-        if (frequency != currentFreq || gainDB != currentGainDB || curve != currentCurve)
-        {
-            smoothedFreq.setCurrentAndTargetValue(frequency);
-            smoothedGain.setCurrentAndTargetValue(gainDB);
-            currentFreq = frequency;
-            currentGainDB = gainDB;
-            needsUpdate = true;
-            // Force immediate coefficient update
-            updateCoefficients();
-        }
     }
     
-    void EQBand::updateCoefficients()
+    void EQBand::setTargetCoefficients(const BiquadCoefficients& target, juce::uint64 shape, bool snap)
     {
-        if (!needsUpdate && !smoothedFreq.isSmoothing() && !smoothedGain.isSmoothing())
-            return;
-        
-        float freq = smoothedFreq.getNextValue();
-        float gain = smoothedGain.getNextValue();
-        
-        if (currentCurve == CurveType::Bell)
+        if (snap || shape != currentShape || !targetInitialised)
         {
-            calculateBellCoefficients(freq, gain, currentQ);
+            // A different curve shape can't be interpolated - switch to it immediately
+            glide.setImmediate(target);
+            coeffRamp.setImmediate(target);
+            snapPending = !target.isUnity();
+            currentShape = shape;
+            targetInitialised = true;
         }
-        else
+        else if (target != glide.target)
         {
-            // For Shelf curves: LF uses low shelf, HF uses high shelf
-            bool isHighShelf = (freq > 2000.0f);
-            calculateShelfCoefficients(freq, gain, isHighShelf);
+            // Frequency/gain moves glide at control rate
+            glide.glideTo(target);
         }
-        
-        needsUpdate = smoothedFreq.isSmoothing() || smoothedGain.isSmoothing();
     }
     
-    void EQBand::calculateBellCoefficients(double freq, double gainDB, double q)
+    void EQBand::setHistory(double previous, double last)
     {
-        if (std::abs(gainDB) < 0.01)
-        {
-            // Bypass - unity gain
-            b0 = 1.0; b1 = 0.0; b2 = 0.0;
-            a0 = 1.0; a1 = 0.0; a2 = 0.0;
-            return;
-        }
-        
-        double A = std::pow(10.0, gainDB / 40.0);
-        double omega = 2.0 * juce::MathConstants<double>::pi * freq / sampleRate;
-        double sinOmega = std::sin(omega);
-        double cosOmega = std::cos(omega);
-        double alpha = sinOmega / (2.0 * q);
+        x1 = y1 = last;
+        x2 = y2 = previous;
+    }
+    
+    SectionState EQBand::getSectionState() const
+    {
+        return SectionState::fromDirectForm(coeffRamp.current, x1, x2, y1, y2);
+    }
+    
+    void EQBand::setSectionState(const SectionState& state, double& previous, double& last)
+    {
+        // Continue from the design the other engine was running, ramping on at the next sample
+        coeffRamp.setImmediate(glide.current);
+        samplesUntilControlUpdate = 0;
         
-        // Peak/Bell filter coefficients
-        b0 = 1.0 + alpha * A;
-        b1 = -2.0 * cosOmega;
-        b2 = 1.0 - alpha * A;
-        a0 = 1.0 + alpha / A;
-        a1 = -2.0 * cosOmega;
-        a2 = 1.0 - alpha / A;
+        x1 = last;
+        x2 = previous;
+        state.toDirectForm(coeffRamp.current, x1, x2, y1, y2);
         
-        // Normalize
-        b0 /= a0; b1 /= a0; b2 /= a0;
-        a1 /= a0; a2 /= a0; a0 = 1.0;
+        previous = y2;
+        last = y1;
     }
     
-    void EQBand::calculateShelfCoefficients(double freq, double gainDB, bool isHighShelf)
+    void EQBand::setControlInterval(int numSamples)
     {
-        if (std::abs(gainDB) < 0.01)
-        {
-            b0 = 1.0; b1 = 0.0; b2 = 0.0;
-            a0 = 1.0; a1 = 0.0; a2 = 0.0;
-            return;
-        }
-        
-        double A = std::pow(10.0, gainDB / 40.0);
-        double omega = 2.0 * juce::MathConstants<double>::pi * freq / sampleRate;
-        double sinOmega = std::sin(omega);
-        double cosOmega = std::cos(omega);
-        double S = 1.0;  // Shelf slope
-        double alpha = sinOmega / 2.0 * std::sqrt((A + 1.0 / A) * (1.0 / S - 1.0) + 2.0);
-        double sqrtA_alpha = 2.0 * std::sqrt(A) * alpha;
+        controlInterval = juce::jlimit(1, ControlRate::maxInterval, numSamples);
+        samplesUntilControlUpdate = 0;
+    }
+    
+    BiquadCoefficientCache::Key EQBand::makeKey(double sampleRate, CurveType curve, float freq, float gainDB, float q)
+    {
+        auto shape = BiquadCoefficientCache::Shape::Bell;
         
-        if (isHighShelf)
-        {
-            // High shelf
-            b0 = A * ((A + 1.0) + (A - 1.0) * cosOmega + sqrtA_alpha);
-            b1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * cosOmega);
-            b2 = A * ((A + 1.0) + (A - 1.0) * cosOmega - sqrtA_alpha);
-            a0 = (A + 1.0) - (A - 1.0) * cosOmega + sqrtA_alpha;
-            a1 = 2.0 * ((A - 1.0) - (A + 1.0) * cosOmega);
-            a2 = (A + 1.0) - (A - 1.0) * cosOmega - sqrtA_alpha;
-        }
-        else
+        if (curve == CurveType::Shelf)
         {
-            // Low shelf
-            b0 = A * ((A + 1.0) - (A - 1.0) * cosOmega + sqrtA_alpha);
-            b1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cosOmega);
-            b2 = A * ((A + 1.0) - (A - 1.0) * cosOmega - sqrtA_alpha);
-            a0 = (A + 1.0) + (A - 1.0) * cosOmega + sqrtA_alpha;
-            a1 = -2.0 * ((A - 1.0) + (A + 1.0) * cosOmega);
-            a2 = (A + 1.0) + (A - 1.0) * cosOmega - sqrtA_alpha;
+            // For Shelf curves: LF uses low shelf, HF uses high shelf
+            shape = (freq > 2000.0f) ? BiquadCoefficientCache::Shape::HighShelf
+                                     : BiquadCoefficientCache::Shape::LowShelf;
         }
         
-        // Normalize
-        b0 /= a0; b1 /= a0; b2 /= a0;
-        a1 /= a0; a2 /= a0; a0 = 1.0;
+        return BiquadCoefficientCache::makeKey(sampleRate, shape, freq, gainDB, q);
     }
     
     float EQBand::processSample(float input)
@@ -146,11 +107,24 @@ namespace Aetheri
         if (!bandEnabled)
             return input;
         
-        updateCoefficients();
+        return processActiveSample(input);
+    }
+    
+    template <typename SampleType>
+    SampleType EQBand::processActiveSample(SampleType input)
+    {
+        if (samplesUntilControlUpdate <= 0)
+        {
+            coeffRamp.rampTo(advanceControl(controlInterval), controlInterval);
+            samplesUntilControlUpdate = controlInterval;
+        }
+        
+        --samplesUntilControlUpdate;
+        const auto& c = coeffRamp.next();
         
-        // Direct Form II Transposed Biquad
+        // Direct Form I Biquad
         double inputD = static_cast<double>(input);
-        double output = b0 * inputD + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        double output = c.b0 * inputD + c.b1 * x1 + c.b2 * x2 - c.a1 * y1 - c.a2 * y2;
         
         // Update state
         x2 = x1;
@@ -158,17 +132,18 @@ namespace Aetheri
         y2 = y1;
         y1 = output;
         
-        return static_cast<float>(output);
+        return static_cast<SampleType>(output);
     }
     
-    void EQBand::processBlock(float* data, int numSamples)
+    template <typename SampleType>
+    void EQBand::processBlock(SampleType* data, int numSamples)
     {
         if (!bandEnabled)
             return;
         
         for (int i = 0; i < numSamples; ++i)
         {
-            data[i] = processSample(data[i]);
+            data[i] = processActiveSample(data[i]);
         }
     }
     
@@ -176,13 +151,17 @@ namespace Aetheri
     // ChannelEQ Implementation
     //==============================================================================
     
+    ChannelEQ::ChannelEQ()
+    {
+        updateActiveMask();
+    }
+    
     void ChannelEQ::prepare(double sampleRate, int samplesPerBlock)
     {
         for (int i = 0; i < NumBands; ++i)
         {
             bands[i].prepare(sampleRate, samplesPerBlock);
         }
-        bandEnergies.fill(0.0f);
     }
     
     void ChannelEQ::reset()
@@ -191,7 +170,6 @@ namespace Aetheri
         {
             band.reset();
         }
-        bandEnergies.fill(0.0f);
     }
     
     void ChannelEQ::setBandParameters(int band, float frequency, float gainDB, float trimDB,
@@ -202,6 +180,7 @@ namespace Aetheri
             float totalGain = gainDB + trimDB;
             float q = Aetheri::BandDefaults::getQ(band);
             bands[band].setParameters(frequency, totalGain, q, curve, enabled);
+            updateActiveMask();
         }
     }
     
@@ -210,6 +189,7 @@ namespace Aetheri
         if (band >= 0 && band < NumBands)
         {
             bandSolo[band] = solo;
+            updateActiveMask();
         }
     }
     
@@ -218,71 +198,156 @@ namespace Aetheri
         if (band >= 0 && band < NumBands)
         {
             bandMute[band] = mute;
+            updateActiveMask();
         }
     }
     
-    bool ChannelEQ::hasAnySolo() const
+    void ChannelEQ::setBandTarget(int band, const BiquadCoefficients& target, juce::uint64 shape, bool snap)
     {
-        for (bool solo : bandSolo)
-        {
-            if (solo) return true;
-        }
-        return false;
+        if (band >= 0 && band < NumBands)
+            bands[band].setTargetCoefficients(target, shape, snap);
     }
     
-    float ChannelEQ::processSample(float input)
+    void ChannelEQ::updateActiveMask()
     {
-        float output = input;
+        static const auto floatKernels = makeKernelTable<float>(std::make_index_sequence<NumMasks>());
+        static const auto doubleKernels = makeKernelTable<double>(std::make_index_sequence<NumMasks>());
+        
         bool anySolo = hasAnySolo();
+        activeMask = 0;
         
-        // Process through all bands in series (passive topology)
-        for (int i = 0; i < NumBands; ++i)
+        for (int band = 0; band < NumBands; ++band)
         {
-            // Check if this band should be processed
-            bool shouldProcess = true;
-            
-            // Solo logic: if any band is soloed, only process soloed bands
-            if (anySolo && !bandSolo[i])
-            {
-                shouldProcess = false;  // Skip non-soloed bands
-            }
-            
-            // Mute logic: if band is muted (and not soloed), bypass it
-            if (bandMute[i] && !bandSolo[i])
-            {
-                shouldProcess = false;  // Skip muted bands
-            }
+            // Solo logic: if any band is soloed, only soloed bands run;
+            // mute logic: a muted band is bypassed unless it is soloed
+            bool active = bands[band].isEnabled()
+                       && !(anySolo && !bandSolo[band])
+                       && !(bandMute[band] && !bandSolo[band]);
             
-            if (shouldProcess)
-            {
-                // Process the band
-                float bandInput = output;
-                float bandOutput = bands[i].processSample(output);
-                
-                // Update energy measurement - measure the band's contribution
-                float energy = std::abs(bandOutput);
-                float bandChange = std::abs(bandOutput - bandInput);
-                bandEnergies[i] = bandEnergies[i] * 0.99f + (energy * 0.5f + bandChange * 0.5f) * 0.01f;
-                
-                output = bandOutput;
-            }
-            // If band is skipped, output remains unchanged (signal passes through)
+            if (active)
+                activeMask |= 1 << band;
         }
         
-        return output;
+        floatKernel = floatKernels[static_cast<size_t>(activeMask)];
+        doubleKernel = doubleKernels[static_cast<size_t>(activeMask)];
+    }
+    
+    template <typename SampleType, size_t... Masks>
+    auto ChannelEQ::makeKernelTable(std::index_sequence<Masks...>) -> std::array<Kernel<SampleType>, NumMasks>
+    {
+        return { { &ChannelEQ::processMasked<SampleType, static_cast<int>(Masks)>... } };
+    }
+    
+    const BiquadCoefficients& ChannelEQ::advanceBandControl(int band, int numSamples)
+    {
+        return bands[band].advanceControl(numSamples);
+    }
+    
+    BiquadCoefficients ChannelEQ::getSettledBandCoefficients(int band) const
+    {
+        return isBandActive(band) ? bands[band].getSettledCoefficients() : BiquadCoefficients {};
     }
     
-    void ChannelEQ::processBlock(juce::AudioBuffer<float>& buffer, int channel)
+    void ChannelEQ::setControlInterval(int numSamples)
     {
-        auto* channelData = buffer.getWritePointer(channel);
-        int numSamples = buffer.getNumSamples();
+        for (auto& band : bands)
+        {
+            band.setControlInterval(numSamples);
+        }
+    }
+    
+    bool ChannelEQ::isSmoothing() const
+    {
+        for (const auto& band : bands)
+        {
+            if (band.isSmoothing()) return true;
+        }
+        return false;
+    }
+    
+    void ChannelEQ::setHistory(double previous, double last)
+    {
+        for (auto& band : bands)
+        {
+            band.setHistory(previous, last);
+        }
+    }
+    
+    std::array<SectionState, ChannelEQ::NumBands> ChannelEQ::getSectionStates() const
+    {
+        std::array<SectionState, NumBands> states {};
+        
+        for (int band = 0; band < NumBands; ++band)
+            if (isBandActive(band))
+                states[static_cast<size_t>(band)] = bands[band].getSectionState();
         
+        return states;
+    }
+    
+    void ChannelEQ::setSectionStates(const std::array<SectionState, NumBands>& states, double previous, double last)
+    {
+        // Inactive bands pass their input straight on to the next band
+        for (int band = 0; band < NumBands; ++band)
+            if (isBandActive(band))
+                bands[band].setSectionState(states[static_cast<size_t>(band)], previous, last);
+    }
+    
+    bool ChannelEQ::isNeutral() const
+    {
+        for (int band = 0; band < NumBands; ++band)
+        {
+            if (!isBandNeutral(band)) return false;
+        }
+        return true;
+    }
+    
+    bool ChannelEQ::hasAnySolo() const
+    {
+        for (bool solo : bandSolo)
+        {
+            if (solo) return true;
+        }
+        return false;
+    }
+    
+    template <int Mask, int Band, typename SampleType>
+    void ChannelEQ::processBandIfActive(SampleType& signal)
+    {
+        // Bands outside the mask compile away - the signal passes through unchanged
+        if constexpr ((Mask & (1 << Band)) != 0)
+            signal = bands[Band].processActiveSample(signal);
+    }
+    
+    template <typename SampleType, int Mask>
+    void ChannelEQ::processMasked(SampleType* data, int numSamples)
+    {
         for (int i = 0; i < numSamples; ++i)
         {
-            channelData[i] = processSample(channelData[i]);
+            // Process through the active bands in series (passive topology)
+            SampleType output = data[i];
+            processBandIfActive<Mask, 0>(output);
+            processBandIfActive<Mask, 1>(output);
+            processBandIfActive<Mask, 2>(output);
+            processBandIfActive<Mask, 3>(output);
+            data[i] = output;
         }
     }
     
+    float ChannelEQ::processSample(float input)
+    {
+        (this->*floatKernel)(&input, 1);
+        return input;
+    }
+    
+    template <typename SampleType>
+    void ChannelEQ::processBlock(SampleType* data, int numSamples)
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            (this->*doubleKernel)(data, numSamples);
+        else
+            (this->*floatKernel)(data, numSamples);
+    }
+    
     //==============================================================================
     // PassiveEQ Implementation
     //==============================================================================
@@ -291,19 +356,24 @@ namespace Aetheri
     {
         sampleRate = newSampleRate;
         
+        // First instance at this rate fills the default-frequency table for everyone
+        coefficientCache->prewarm(sampleRate);
+        
         for (auto& eq : channelEQs)
         {
             eq.prepare(sampleRate, samplesPerBlock);
         }
+        stereoKernel.reset();
+        ecoKernel.reset();
+        parallelKernel.reset();
+        parallelFallback = false;
+        linearPhase.prepare(sampleRate, samplesPerBlock);
         
         inputGain.reset(sampleRate, 0.02);
         outputTrim.reset(sampleRate, 0.02);
         
         inputGain.setCurrentAndTargetValue(1.0f);
         outputTrim.setCurrentAndTargetValue(1.0f);
-        
-        inputLevels.fill(0.0f);
-        outputLevels.fill(0.0f);
     }
     
     void PassiveEQ::reset()
@@ -312,8 +382,10 @@ namespace Aetheri
         {
             eq.reset();
         }
-        inputLevels.fill(0.0f);
-        outputLevels.fill(0.0f);
+        stereoKernel.reset();
+        ecoKernel.reset();
+        parallelKernel.reset();
+        linearPhase.reset();
     }
     
     void PassiveEQ::setInputGain(float gainDB)
@@ -336,6 +408,290 @@ namespace Aetheri
         channelsLinked = linked;
     }
     
+    bool PassiveEQ::isNeutral() const
+    {
+        // The FIR delay has to stay in the path even when flat
+        if (engine == Engine::LinearPhase)
+            return false;
+        
+        if (inputGain.isSmoothing() || outputTrim.isSmoothing()
+            || inputGain.getTargetValue() != 1.0f || outputTrim.getTargetValue() != 1.0f)
+            return false;
+        
+        return channelEQs[0].isNeutral() && channelEQs[1].isNeutral();
+    }
+    
+    template <typename SampleType>
+    void PassiveEQ::trackSkippedInput(const juce::dsp::AudioBlock<SampleType>& block)
+    {
+        int numSamples = static_cast<int>(block.getNumSamples());
+        if (block.getNumChannels() < 2 || numSamples < 2)
+            return;
+        
+        // Keep the filter history on the live signal so the EQ rejoins the chain without a step
+        alignas(16) double previous[2], last[2];
+        
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            previous[ch] = block.getSample(ch, numSamples - 2);
+            last[ch] = block.getSample(ch, numSamples - 1);
+        }
+        
+        if (midSideMode)
+        {
+            for (auto* frame : { previous, last })
+            {
+                double l = frame[0], r = frame[1];
+                frame[0] = (l + r) * 0.5;
+                frame[1] = (l - r) * 0.5;
+            }
+        }
+        
+        stereoKernel.setHistory(previous, last);
+        ecoKernel.setHistory(previous, last);
+        
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            channelEQs[ch].setHistory(previous[ch], last[ch]);
+            inputHistory[0][ch] = previous[ch];
+            inputHistory[1][ch] = last[ch];
+        }
+    }
+    
+    void PassiveEQ::setControlInterval(int numSamples)
+    {
+        controlInterval = juce::jlimit(1, ControlRate::maxInterval, numSamples);
+        
+        for (auto& eq : channelEQs)
+        {
+            eq.setControlInterval(controlInterval);
+        }
+    }
+    
+    void PassiveEQ::setEngine(Engine newEngine)
+    {
+        if (newEngine == engine)
+            return;
+        
+        // Minimum-phase engines hand their band states over, so e.g. switching eco precision
+        // during playback carries on without a step; the linear-phase FIR starts clean
+        CascadeStates states;
+        const bool handOver = engine != Engine::LinearPhase && newEngine != Engine::LinearPhase
+                           && getCascadeStates(states);
+        engine = newEngine;
+        
+        if (handOver)
+            setCascadeStates(states);
+        else if (engine == Engine::Vectorised)
+            stereoKernel.reset();
+        else if (engine == Engine::Eco)
+            ecoKernel.reset();
+        else if (engine == Engine::Parallel)
+        {
+            parallelKernel.reset();
+            parallelFallback = false;
+        }
+        else if (engine == Engine::LinearPhase)
+            linearPhase.reset();
+        else
+            for (auto& eq : channelEQs)
+                eq.reset();
+    }
+    
+    bool PassiveEQ::getCascadeStates(CascadeStates& states) const
+    {
+        SectionState kernelStates[ChannelEQ::NumBands][2];
+        
+        auto fromKernel = [&] (const auto& kernel)
+        {
+            kernel.getSectionStates(kernelStates);
+            
+            for (size_t ch = 0; ch < states.size(); ++ch)
+                for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                    states[ch][static_cast<size_t>(band)] = kernelStates[band][ch];
+        };
+        
+        switch (engine)
+        {
+            case Engine::Reference:
+                for (size_t ch = 0; ch < states.size(); ++ch)
+                    states[ch] = channelEQs[ch].getSectionStates();
+                return true;
+            
+            case Engine::Vectorised:
+                fromKernel(stereoKernel);
+                return true;
+            
+            case Engine::Eco:
+                fromKernel(ecoKernel);
+                return true;
+            
+            case Engine::Parallel:
+                if (parallelFallback)
+                {
+                    fromKernel(stereoKernel);
+                    return true;
+                }
+                
+                return ParallelBiquadKernel::toCascadeStates(parallelCascades[0], parallelKernel.getSectionStates(0), states[0])
+                    && ParallelBiquadKernel::toCascadeStates(parallelCascades[1], parallelKernel.getSectionStates(1), states[1]);
+            
+            case Engine::LinearPhase:
+            default:
+                return false;
+        }
+    }
+    
+    template <typename Kernel>
+    void PassiveEQ::loadKernelDesigns(Kernel& kernel)
+    {
+        // The designs the previous engine was running, so the states mean the same thing
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const auto& eq = channelEQs[static_cast<size_t>(ch)];
+            
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+            {
+                if (eq.isBandNeutral(band))
+                    kernel.setBandBypassed(band, ch);
+                else
+                    kernel.setBandCoefficients(band, ch, eq.getBand(band).getCoefficients());
+            }
+        }
+    }
+    
+    void PassiveEQ::setCascadeStates(const CascadeStates& states)
+    {
+        SectionState kernelStates[ChannelEQ::NumBands][2];
+        
+        for (size_t ch = 0; ch < states.size(); ++ch)
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                kernelStates[band][ch] = states[ch][static_cast<size_t>(band)];
+        
+        auto toSerialKernel = [&]
+        {
+            loadKernelDesigns(stereoKernel);
+            stereoKernel.setSectionStates(kernelStates, inputHistory[0], inputHistory[1]);
+        };
+        
+        switch (engine)
+        {
+            case Engine::Reference:
+                for (size_t ch = 0; ch < states.size(); ++ch)
+                    channelEQs[ch].setSectionStates(states[ch], inputHistory[0][ch], inputHistory[1][ch]);
+                break;
+            
+            case Engine::Vectorised:
+                toSerialKernel();
+                break;
+            
+            case Engine::Eco:
+                loadKernelDesigns(ecoKernel);
+                ecoKernel.setSectionStates(kernelStates, inputHistory[1]);
+                break;
+            
+            case Engine::Parallel:
+            {
+                bool split = true;
+                
+                for (size_t ch = 0; ch < parallelCascades.size(); ++ch)
+                {
+                    const auto& eq = channelEQs[ch];
+                    
+                    for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                        parallelCascades[ch][static_cast<size_t>(band)] = eq.isBandActive(band) ? eq.getBand(band).getCoefficients()
+                                                                                               : BiquadCoefficients {};
+                    
+                    ParallelBiquadKernel::SectionStates sectionStates;
+                    split = parallelKernel.setCascade(static_cast<int>(ch), parallelCascades[ch], 1)
+                         && ParallelBiquadKernel::toParallelStates(parallelCascades[ch], states[ch], sectionStates)
+                         && split;
+                    
+                    if (split)
+                        parallelKernel.setSectionStates(static_cast<int>(ch), sectionStates);
+                }
+                
+                // No usable split: carry on in the serial fallback from the same states
+                parallelFallback = !split;
+                
+                if (parallelFallback)
+                    toSerialKernel();
+                break;
+            }
+            
+            case Engine::LinearPhase:
+            default:
+                break;
+        }
+    }
+    
+    template <typename SampleType>
+    void PassiveEQ::rememberInput(const SampleType* left, const SampleType* right, int numSamples)
+    {
+        // Newest frame last; a one-sample step moves the history along by one
+        if (numSamples >= 2)
+        {
+            for (int frame = 0; frame < 2; ++frame)
+            {
+                inputHistory[frame][0] = left[numSamples - 2 + frame];
+                inputHistory[frame][1] = right[numSamples - 2 + frame];
+            }
+        }
+        else if (numSamples == 1)
+        {
+            inputHistory[0][0] = inputHistory[1][0];
+            inputHistory[0][1] = inputHistory[1][1];
+            inputHistory[1][0] = left[0];
+            inputHistory[1][1] = right[0];
+        }
+    }
+    
+    void PassiveEQ::setFoldedFilters(const BiquadCoefficients& highPass, const BiquadCoefficients& lowPass)
+    {
+        foldedHighPass = highPass;
+        foldedLowPass = lowPass;
+    }
+    
+    int PassiveEQ::getLatencySamples() const
+    {
+        return engine == Engine::LinearPhase ? linearPhase.getLatencySamples() : 0;
+    }
+    
+    bool PassiveEQ::areChannelsMatched() const
+    {
+        if (midSideMode || isSmoothing())
+            return false;
+        
+        for (int band = 0; band < ChannelEQ::NumBands; ++band)
+        {
+            if (channelEQs[0].getSettledBandCoefficients(band) != channelEQs[1].getSettledBandCoefficients(band))
+                return false;
+        }
+        
+        return true;
+    }
+    
+    int PassiveEQ::getTailSamples(double attenuation) const
+    {
+        // The FIR ends where it ends; the biquad bands decay one after another
+        if (engine == Engine::LinearPhase)
+            return LinearPhaseEQ::getFilterLength(sampleRate) - linearPhase.getLatencySamples();
+        
+        int tail = 0;
+        
+        for (const auto& eq : channelEQs)
+        {
+            int channelTail = 0;
+            
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                channelTail += eq.getSettledBandCoefficients(band).getDecaySamples(attenuation);
+            
+            tail = std::max(tail, channelTail);
+        }
+        
+        return tail;
+    }
+    
     void PassiveEQ::setBandParameters(int band, int channel,
                                        float frequency, float gainDB, float trimDB,
                                        EQBand::CurveType curve, bool enabled)
@@ -380,101 +736,266 @@ namespace Aetheri
         }
     }
     
-    void PassiveEQ::processBlock(juce::AudioBuffer<float>& buffer)
+    void PassiveEQ::setCoefficientTargets(const CoefficientSnapshot& snapshot, bool snap)
+    {
+        // The snapshot has the channel link resolved already
+        for (size_t ch = 0; ch < channelEQs.size(); ++ch)
+        {
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+            {
+                channelEQs[ch].setBandTarget(band, snapshot.bands[ch][static_cast<size_t>(band)],
+                                             snapshot.bandShapes[ch][static_cast<size_t>(band)], snap);
+            }
+        }
+    }
+    
+    template <typename SampleType>
+    void PassiveEQ::processBlock(const juce::dsp::AudioBlock<SampleType>& block)
     {
-        if (buffer.getNumChannels() < 2)
+        if (block.getNumChannels() < 2)
             return;
         
-        int numSamples = buffer.getNumSamples();
+        int numSamples = static_cast<int>(block.getNumSamples());
+        auto* left = block.getChannelPointer(0);
+        auto* right = block.getChannelPointer(1);
         
-        // Apply input gain and measure input levels
-        for (int ch = 0; ch < 2; ++ch)
+        // Input gain and the M/S encode in one pass
+        applyInputStage(left, right, numSamples);
+        
+        // Process EQ for both channels
+        if (engine == Engine::Reference)
         {
-            auto* data = buffer.getWritePointer(ch);
-            float maxLevel = 0.0f;
-            
-            for (int i = 0; i < numSamples; ++i)
+            rememberInput(left, right, numSamples);
+            channelEQs[0].processBlock(left, numSamples);
+            channelEQs[1].processBlock(right, numSamples);
+        }
+        else if (engine == Engine::LinearPhase)
+        {
+            updateLinearPhaseResponse();
+            linearPhase.process(left, right, numSamples);
+        }
+        else
+        {
+            // Whole block at once when settled, control-rate steps while any band glides
+            for (int start = 0; start < numSamples;)
             {
-                data[i] *= inputGain.getNextValue();
-                maxLevel = std::max(maxLevel, std::abs(data[i]));
+                bool smoothing = channelEQs[0].isSmoothing() || channelEQs[1].isSmoothing();
+                int stepLength = smoothing ? std::min(controlInterval, numSamples - start)
+                                           : numSamples - start;
+                
+                if (engine == Engine::Vectorised)
+                {
+                    updateKernelCoefficients(stereoKernel, stepLength);
+                    rememberInput(left + start, right + start, stepLength);
+                    stereoKernel.processBlock(left + start, right + start, stepLength);
+                }
+                else if (engine == Engine::Eco)
+                {
+                    updateKernelCoefficients(ecoKernel, stepLength);
+                    rememberInput(left + start, right + start, stepLength);
+                    ecoKernel.processBlock(left + start, right + start, stepLength);
+                }
+                else
+                {
+                    processParallelStep(left + start, right + start, stepLength);
+                }
+                
+                start += stepLength;
             }
-            
-            // Slow-moving level for VU (RMS-like)
-            inputLevels[ch] = inputLevels[ch] * 0.95f + maxLevel * 0.05f;
         }
         
-        // Encode to M/S if needed
-        if (midSideMode)
+        // M/S decode and output trim in one pass
+        applyOutputStage(left, right, numSamples);
+    }
+    
+    template <typename Kernel>
+    void PassiveEQ::updateKernelCoefficients(Kernel& kernel, int numSamples)
+    {
+        // One design per band per control step; the kernel interpolates across the step
+        for (int ch = 0; ch < 2; ++ch)
         {
-            encodeToMidSide(buffer);
+            auto& eq = channelEQs[ch];
+            
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+            {
+                const auto& target = eq.advanceBandControl(band, numSamples);
+                const int rampLength = eq.takeBandSnap(band) ? 1 : numSamples;
+                
+                // Settled unity bands are skipped by the kernel rather than run as identity,
+                // after gliding their last step into unity
+                if (!eq.isBandNeutral(band) || (eq.isBandActive(band) && !kernel.isBandUnity(band, ch)))
+                    kernel.rampBandCoefficients(band, ch, target, rampLength);
+                else
+                    kernel.setBandBypassed(band, ch);
+            }
         }
+    }
+    
+    void PassiveEQ::updateLinearPhaseResponse()
+    {
+        // Only the settled curve is rendered; parameter moves reach the FIR as crossfades
+        LinearPhaseEQ::Response response;
         
-        // Process EQ for each channel
         for (int ch = 0; ch < 2; ++ch)
         {
-            channelEQs[ch].processBlock(buffer, ch);
+            auto& sections = response.sections[ch];
+            
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                sections[band] = channelEQs[ch].getSettledBandCoefficients(band);
+            
+            sections[ChannelEQ::NumBands] = foldedHighPass;
+            sections[ChannelEQ::NumBands + 1] = foldedLowPass;
         }
         
-        // Decode from M/S if needed
-        if (midSideMode)
-        {
-            decodeFromMidSide(buffer);
-        }
+        linearPhase.setResponse(response);
+    }
+    
+    bool PassiveEQ::updateParallelCoefficients(int numSamples)
+    {
+        bool split = true;
         
-        // Apply output trim and measure output levels
         for (int ch = 0; ch < 2; ++ch)
         {
-            auto* data = buffer.getWritePointer(ch);
-            float maxLevel = 0.0f;
+            auto& eq = channelEQs[ch];
+            auto& cascade = parallelCascades[ch];
+            bool snap = false;
             
-            for (int i = 0; i < numSamples; ++i)
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
             {
-                data[i] *= outputTrim.getNextValue();
-                maxLevel = std::max(maxLevel, std::abs(data[i]));
+                const auto& target = eq.advanceBandControl(band, numSamples);
+                snap = eq.takeBandSnap(band) || snap;
+                cascade[band] = eq.isBandActive(band) ? target : BiquadCoefficients {};
             }
             
-            outputLevels[ch] = outputLevels[ch] * 0.95f + maxLevel * 0.05f;
+            // The split is redone per control step; the kernel glides the parallel form
+            split = parallelKernel.setCascade(ch, cascade, snap ? 1 : numSamples) && split;
         }
+        
+        return split;
     }
     
-    float PassiveEQ::getBandEnergy(int band, int channel) const
+    template <typename SampleType>
+    void PassiveEQ::processParallelStep(SampleType* left, SampleType* right, int numSamples)
     {
-        if (channel >= 0 && channel < 2)
+        if (updateParallelCoefficients(numSamples))
         {
-            return channelEQs[channel].getBandEnergy(band);
+            // Back from the serial kernel - the sections restart from rest
+            if (parallelFallback)
+            {
+                parallelKernel.reset();
+                parallelFallback = false;
+            }
+            
+            rememberInput(left, right, numSamples);
+            parallelKernel.processBlock(left, right, numSamples);
+            return;
         }
-        return 0.0f;
+        
+        // Coincident or ill-conditioned poles have no usable split - run the cascade in series
+        // until they separate again; the handover seeds the serial history from the input
+        const bool handover = !parallelFallback;
+        
+        if (handover)
+        {
+            stereoKernel.reset();
+            stereoKernel.setHistory(inputHistory[0], inputHistory[1]);
+            parallelFallback = true;
+        }
+        
+        for (int ch = 0; ch < 2; ++ch)
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                stereoKernel.rampBandCoefficients(band, ch, parallelCascades[ch][band], handover ? 1 : numSamples);
+        
+        rememberInput(left, right, numSamples);
+        stereoKernel.processBlock(left, right, numSamples);
     }
     
-    void PassiveEQ::encodeToMidSide(juce::AudioBuffer<float>& buffer)
+    template <typename SampleType>
+    void PassiveEQ::applyInputStage(SampleType* left, SampleType* right, int numSamples)
     {
-        auto* left = buffer.getWritePointer(0);
-        auto* right = buffer.getWritePointer(1);
-        int numSamples = buffer.getNumSamples();
+        alignas(16) SampleType gains[gainChunkSize];
+        const bool encode = midSideMode;
         
-        for (int i = 0; i < numSamples; ++i)
+        for (int start = 0; start < numSamples; start += gainChunkSize)
         {
-            float l = left[i];
-            float r = right[i];
+            const int n = std::min(gainChunkSize, numSamples - start);
+            fillGains(inputGain, gains, n);
+            
+            auto* l = left + start;
+            auto* r = right + start;
             
-            left[i] = (l + r) * 0.5f;   // Mid
-            right[i] = (l - r) * 0.5f;  // Side
+            for (int i = 0; i < n; ++i)
+            {
+                const SampleType gainedLeft = l[i] * gains[i];
+                const SampleType gainedRight = r[i] * gains[i];
+                
+                if (encode)
+                {
+                    l[i] = (gainedLeft + gainedRight) * SampleType(0.5);   // Mid
+                    r[i] = (gainedLeft - gainedRight) * SampleType(0.5);   // Side
+                }
+                else
+                {
+                    l[i] = gainedLeft;
+                    r[i] = gainedRight;
+                }
+            }
         }
     }
     
-    void PassiveEQ::decodeFromMidSide(juce::AudioBuffer<float>& buffer)
+    template <typename SampleType>
+    void PassiveEQ::applyOutputStage(SampleType* left, SampleType* right, int numSamples)
     {
-        auto* mid = buffer.getWritePointer(0);
-        auto* side = buffer.getWritePointer(1);
-        int numSamples = buffer.getNumSamples();
+        alignas(16) SampleType gains[gainChunkSize];
+        const bool decode = midSideMode;
         
-        for (int i = 0; i < numSamples; ++i)
+        for (int start = 0; start < numSamples; start += gainChunkSize)
         {
-            float m = mid[i];
-            float s = side[i];
+            const int n = std::min(gainChunkSize, numSamples - start);
+            fillGains(outputTrim, gains, n);
+            
+            auto* l = left + start;
+            auto* r = right + start;
             
-            mid[i] = m + s;   // Left
-            side[i] = m - s;  // Right
+            for (int i = 0; i < n; ++i)
+            {
+                SampleType outLeft = l[i], outRight = r[i];
+                
+                if (decode)
+                {
+                    outLeft = l[i] + r[i];    // Left
+                    outRight = l[i] - r[i];   // Right
+                }
+                
+                l[i] = outLeft * gains[i];
+                r[i] = outRight * gains[i];
+            }
         }
     }
+    
+    template <typename SampleType>
+    void PassiveEQ::fillGains(juce::SmoothedValue<float>& smoother, SampleType* gains, int numSamples)
+    {
+        // One smoother step per sample for both channels; a settled gain is just a fill
+        if (smoother.isSmoothing())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                gains[i] = static_cast<SampleType>(smoother.getNextValue());
+        }
+        else
+        {
+            std::fill(gains, gains + numSamples, static_cast<SampleType>(smoother.getTargetValue()));
+        }
+    }
+    
+    template float EQBand::processActiveSample<float>(float);
+    template double EQBand::processActiveSample<double>(double);
+    template void EQBand::processBlock<float>(float*, int);
+    template void EQBand::processBlock<double>(double*, int);
+    template void ChannelEQ::processBlock<float>(float*, int);
+    template void ChannelEQ::processBlock<double>(double*, int);
+    template void PassiveEQ::trackSkippedInput<float>(const juce::dsp::AudioBlock<float>&);
+    template void PassiveEQ::trackSkippedInput<double>(const juce::dsp::AudioBlock<double>&);
+    template void PassiveEQ::processBlock<float>(const juce::dsp::AudioBlock<float>&);
+    template void PassiveEQ::processBlock<double>(const juce::dsp::AudioBlock<double>&);
 }
@@ -10,6 +10,13 @@
 #include <juce_dsp/juce_dsp.h>
 #include <juce_core/juce_core.h>
 #include "Parameters.h"
+#include "BiquadCoefficients.h"
+#include "BiquadCoefficientCache.h"
+#include "CoefficientSnapshot.h"
+#include "StereoBiquadKernel.h"
+#include "StereoSVFKernel.h"
+#include "ParallelBiquadKernel.h"
+#include "LinearPhaseEQ.h"
 
 namespace Aetheri
 {
@@ -26,30 +33,64 @@ namespace Aetheri
         
         void prepare(double sampleRate, int samplesPerBlock);
         void reset();
+        void setHistory(double previous, double last);
         
+        // State for handing over to another engine, and taking it back after the given
+        // input history (passed on as this band's output history, for the next band)
+        SectionState getSectionState() const;
+        void setSectionState(const SectionState& state, double& previous, double& last);
+        
+        // Display values and the enable switch; the design arrives through setTargetCoefficients()
         void setParameters(float frequency, float gainDB, float q, CurveType curve, bool enabled);
-        void updateCoefficients();
+        
+        // Glides to a design made off the audio thread, or jumps to it when snapping or when
+        // the shape (curve, Q or sample rate) differs from the current one
+        void setTargetCoefficients(const BiquadCoefficients& target, juce::uint64 shape, bool snap);
+        
+        // Cache key of a band design; Shelf becomes a low or high shelf by frequency
+        static BiquadCoefficientCache::Key makeKey(double sampleRate, CurveType curve, float freq, float gainDB, float q);
+        
+        // Control-rate engine: the glide moves once every interval samples and the
+        // coefficients are interpolated per sample in between
+        void setControlInterval(int numSamples);
+        const BiquadCoefficients& advanceControl(int numSamples) { return glide.advance(numSamples); }
+        bool isSmoothing() const { return glide.isGliding(); }
+        
+        // Settled at a unity design - the band can be left out of the chain
+        bool isNeutral() const { return !isSmoothing() && glide.current.isUnity(); }
+        
+        // True once after the design jumped instead of gliding (prepare, curve/Q change)
+        bool takeSnap() { bool snap = snapPending; snapPending = false; return snap; }
         
         float processSample(float input);
-        void processBlock(float* data, int numSamples);
+        template <typename SampleType>
+        void processBlock(SampleType* data, int numSamples);
+        
+        // processSample without the enabled check, for callers that resolved it already
+        template <typename SampleType>
+        SampleType processActiveSample(SampleType input);
         
         // For visualization
         float getCurrentGain() const { return currentGainDB; }
         float getCurrentFrequency() const { return currentFreq; }
         bool isEnabled() const { return bandEnabled; }
         
+        // For the block kernels
+        const BiquadCoefficients& getCoefficients() const { return glide.current; }
+        // Where the glide lands
+        BiquadCoefficients getSettledCoefficients() const { return glide.target; }
+        
     private:
         // Biquad state (64-bit precision)
         double x1 = 0.0, x2 = 0.0;
         double y1 = 0.0, y2 = 0.0;
         
-        // Coefficients
-        double b0 = 1.0, b1 = 0.0, b2 = 0.0;
-        double a0 = 1.0, a1 = 0.0, a2 = 0.0;
-        
-        // Smoothed parameters
-        juce::SmoothedValue<float> smoothedGain;
-        juce::SmoothedValue<float> smoothedFreq;
+        // Coefficients (glide between snapshot designs, and the per-sample ramp along it)
+        BiquadCoefficientGlide glide;
+        BiquadCoefficientRamp coeffRamp;
+        juce::uint64 currentShape = 0;
+        int controlInterval = ControlRate::defaultInterval;
+        int samplesUntilControlUpdate = 0;
         
         // Current state
         float currentFreq = 1000.0f;
@@ -58,11 +99,8 @@ namespace Aetheri
         CurveType currentCurve = CurveType::Bell;
         bool bandEnabled = true;
         
-        double sampleRate = 44100.0;
-        bool needsUpdate = true;
-        
-        void calculateBellCoefficients(double freq, double gainDB, double q);
-        void calculateShelfCoefficients(double freq, double gainDB, bool isHighShelf);
+        bool targetInitialised = false;
+        bool snapPending = false;
     };
     
     /**
@@ -74,7 +112,7 @@ namespace Aetheri
     public:
         static constexpr int NumBands = 4;
         
-        ChannelEQ() = default;
+        ChannelEQ();
         
         void prepare(double sampleRate, int samplesPerBlock);
         void reset();
@@ -84,24 +122,61 @@ namespace Aetheri
         
         void setBandSolo(int band, bool solo);
         void setBandMute(int band, bool mute);
+        void setBandTarget(int band, const BiquadCoefficients& target, juce::uint64 shape, bool snap);
+        
+        void setControlInterval(int numSamples);
+        void setHistory(double previous, double last);
+        bool isSmoothing() const;
+        
+        // Active bands' states for an engine handover (identity for the others)
+        std::array<SectionState, NumBands> getSectionStates() const;
+        void setSectionStates(const std::array<SectionState, NumBands>& states, double previous, double last);
+        bool isNeutral() const;
         
-        void processBlock(juce::AudioBuffer<float>& buffer, int channel);
+        template <typename SampleType>
+        void processBlock(SampleType* data, int numSamples);
         float processSample(float input);
         
-        // For visualization - get band energy
-        float getBandEnergy(int band) const { return bandEnergies[band]; }
         const EQBand& getBand(int band) const { return bands[band]; }
         
+        // Block-rate view of a band (solo/mute/enable resolved) for the vectorised engine
+        bool isBandActive(int band) const { return band >= 0 && band < NumBands && (activeMask & (1 << band)) != 0; }
+        bool isBandNeutral(int band) const { return !isBandActive(band) || bands[band].isNeutral(); }
+        bool takeBandSnap(int band) { return bands[band].takeSnap(); }
+        const BiquadCoefficients& advanceBandControl(int band, int numSamples);
+        
+        // Settled design of a band, unity while it is inactive
+        BiquadCoefficients getSettledBandCoefficients(int band) const;
+        
     private:
         std::array<EQBand, NumBands> bands;
-        std::array<float, NumBands> bandEnergies = {0.0f, 0.0f, 0.0f, 0.0f};
         std::array<bool, NumBands> bandSolo = {false, false, false, false};
         std::array<bool, NumBands> bandMute = {false, false, false, false};
         
         // Passive topology: bands interact through slight phase/gain coupling
         float passiveCoupling = 0.02f;  // Subtle interaction between bands
         
+        // Solo/mute/enable resolved into one bit per band whenever any of them changes,
+        // selecting a kernel compiled for exactly that set of bands (per sample type)
+        template <typename SampleType>
+        using Kernel = void (ChannelEQ::*)(SampleType*, int);
+        static constexpr int NumMasks = 1 << NumBands;
+        
+        int activeMask = 0;
+        Kernel<float> floatKernel = nullptr;
+        Kernel<double> doubleKernel = nullptr;
+        
         bool hasAnySolo() const;
+        void updateActiveMask();
+        
+        template <typename SampleType, int Mask>
+        void processMasked(SampleType* data, int numSamples);
+        
+        template <int Mask, int Band, typename SampleType>
+        void processBandIfActive(SampleType& signal);
+        
+        template <typename SampleType, size_t... Masks>
+        static auto makeKernelTable(std::index_sequence<Masks...>) -> std::array<Kernel<SampleType>, NumMasks>;
     };
     
     /**
@@ -111,6 +186,16 @@ namespace Aetheri
     class PassiveEQ
     {
     public:
+        /**
+         * EQ processing engine
+         * Reference: per-channel, per-sample EQBand path (original 64-bit behaviour)
+         * Vectorised: StereoBiquadKernel, both channels per SIMD register
+         * Eco: StereoSVFKernel, 32-bit state-variable sections for high instance counts
+         * Parallel: ParallelBiquadKernel, the four bands split into independent sections
+         * LinearPhase: LinearPhaseEQ, the settled band and folded HPF/LPF magnitude as an FIR
+         */
+        enum class Engine { Reference, Vectorised, Parallel, LinearPhase, Eco };
+        
         PassiveEQ() = default;
         
         void prepare(double sampleRate, int samplesPerBlock);
@@ -120,6 +205,18 @@ namespace Aetheri
         void setOutputTrim(float gainDB);
         void setStereoMode(bool isMidSide);
         void setChannelLink(bool linked);
+        void setControlInterval(int numSamples);
+        void setEngine(Engine newEngine);
+        Engine getEngine() const { return engine; }
+        
+        // HPF/LPF designs folded into the linear-phase FIR (unity when off)
+        void setFoldedFilters(const BiquadCoefficients& highPass, const BiquadCoefficients& lowPass);
+        
+        // Samples of delay added by the current engine
+        int getLatencySamples() const;
+        // Samples the output rings on for once the input stops, beyond the latency
+        int getTailSamples(double attenuation) const;
+        static int getLinearPhaseLatency(double sampleRate) { return LinearPhaseEQ::getFilterLength(sampleRate) / 2; }
         
         // Set parameters for a specific band and channel
         void setBandParameters(int band, int channel, 
@@ -129,15 +226,35 @@ namespace Aetheri
         void setBandSolo(int band, int channel, bool solo);
         void setBandMute(int band, int channel, bool mute);
         
-        void processBlock(juce::AudioBuffer<float>& buffer);
+        // Band designs from a snapshot, glided towards (or jumped to when snapping)
+        void setCoefficientTargets(const CoefficientSnapshot& snapshot, bool snap);
         
-        // For visualization
-        float getBandEnergy(int band, int channel) const;
-        float getInputLevel(int channel) const { return inputLevels[channel]; }
-        float getOutputLevel(int channel) const { return outputLevels[channel]; }
+        // Unity gains and every band neutral on both channels (M/S round trip included)
+        bool isNeutral() const;
+        // Any band on either channel still gliding to its design
+        bool isSmoothing() const { return channelEQs[0].isSmoothing() || channelEQs[1].isSmoothing(); }
+        // L/R with the same settled bands on both channels: identical input stays identical
+        bool areChannelsMatched() const;
+        // Called instead of processBlock while the chain skips the EQ
+        template <typename SampleType>
+        void trackSkippedInput(const juce::dsp::AudioBlock<SampleType>& block);
+        
+        template <typename SampleType>
+        void processBlock(const juce::dsp::AudioBlock<SampleType>& block);
         
     private:
         std::array<ChannelEQ, 2> channelEQs;
+        StereoBiquadKernel stereoKernel;
+        StereoSVFKernel ecoKernel;
+        ParallelBiquadKernel parallelKernel;
+        std::array<ParallelBiquadKernel::Cascade, 2> parallelCascades;
+        bool parallelFallback = false;
+        alignas(16) double inputHistory[2][2] = {};  // Last two input frames [frame][lane], for engine handovers
+        LinearPhaseEQ linearPhase;
+        BiquadCoefficients foldedHighPass, foldedLowPass;
+        juce::SharedResourcePointer<BiquadCoefficientCache> coefficientCache;
+        Engine engine = Engine::Vectorised;
+        int controlInterval = ControlRate::defaultInterval;
         
         juce::SmoothedValue<float> inputGain;
         juce::SmoothedValue<float> outputTrim;
@@ -145,13 +262,31 @@ namespace Aetheri
         bool midSideMode = false;
         bool channelsLinked = true;
         
-        // Level metering
-        std::array<float, 2> inputLevels = {0.0f, 0.0f};
-        std::array<float, 2> outputLevels = {0.0f, 0.0f};
-        
         double sampleRate = 44100.0;
         
-        void encodeToMidSide(juce::AudioBuffer<float>& buffer);
-        void decodeFromMidSide(juce::AudioBuffer<float>& buffer);
+        // Fused per-block passes either side of the EQ, gains shared by both channels
+        static constexpr int gainChunkSize = 64;
+        template <typename SampleType>
+        void applyInputStage(SampleType* left, SampleType* right, int numSamples);
+        template <typename SampleType>
+        void applyOutputStage(SampleType* left, SampleType* right, int numSamples);
+        template <typename SampleType>
+        static void fillGains(juce::SmoothedValue<float>& smoother, SampleType* gains, int numSamples);
+        template <typename Kernel>
+        void updateKernelCoefficients(Kernel& kernel, int numSamples);
+        bool updateParallelCoefficients(int numSamples);
+        
+        // Band states of the running minimum-phase engine [channel][band], in transposed
+        // direct form II; false when they can't be expressed exactly
+        using CascadeStates = std::array<std::array<SectionState, ChannelEQ::NumBands>, 2>;
+        bool getCascadeStates(CascadeStates& states) const;
+        void setCascadeStates(const CascadeStates& states);
+        template <typename Kernel>
+        void loadKernelDesigns(Kernel& kernel);
+        template <typename SampleType>
+        void rememberInput(const SampleType* left, const SampleType* right, int numSamples);
+        template <typename SampleType>
+        void processParallelStep(SampleType* left, SampleType* right, int numSamples);
+        void updateLinearPhaseResponse();
     };
 }
@@ -0,0 +1,623 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    PolyphaseOversampler Implementation
+  ==============================================================================
+*/
+
+#include "PolyphaseOversampler.h"
+
+namespace Aetheri
+{
+    namespace
+    {
+       #if JUCE_USE_SIMD
+        using DoublePair = juce::dsp::SIMDRegister<double>;
+       #else
+        // Scalar stand-in with the subset of the SIMDRegister interface used below
+        struct DoublePair
+        {
+            static constexpr size_t SIMDNumElements = 2;
+            double v[2];
+
+            static DoublePair expand(double s) noexcept                 { return { { s, s } }; }
+            static DoublePair fromRawArray(const double* a) noexcept    { return { { a[0], a[1] } }; }
+            void copyToRawArray(double* a) const noexcept               { a[0] = v[0]; a[1] = v[1]; }
+
+            DoublePair operator+(DoublePair o) const noexcept { return { { v[0] + o.v[0], v[1] + o.v[1] } }; }
+            DoublePair operator-(DoublePair o) const noexcept { return { { v[0] - o.v[0], v[1] - o.v[1] } }; }
+            DoublePair operator*(DoublePair o) const noexcept { return { { v[0] * o.v[0], v[1] * o.v[1] } }; }
+        };
+       #endif
+
+        static_assert(DoublePair::SIMDNumElements == 2, "PolyphaseOversampler expects one channel per 64-bit SIMD lane");
+
+        constexpr double stopbandAttenuationdB = 100.0;
+        constexpr int maxAllpassSections = 16;  // Per path
+        constexpr int maxTaps = 64;
+
+        // Stage 1 keeps the host band up to 0.45 fs; later stages only have to clear the images
+        // of what stage 1 let through, so their transition bands widen with the rate
+        double getTransitionWidth(int stageIndex)
+        {
+            return stageIndex == 0 ? 0.05 : 0.5 - 0.55 / static_cast<double>(1 << stageIndex);
+        }
+
+        //==============================================================================
+        // Polyphase allpass half-band (elliptic prototype, closed-form design)
+
+        std::vector<double> designAllpassHalfBand(double transitionWidth, double attenuationdB)
+        {
+            const double pi = juce::MathConstants<double>::pi;
+
+            // Selectivity and nome of the elliptic prototype
+            double k = std::tan((1.0 - transitionWidth * 2.0) * pi / 4.0);
+            k *= k;
+            const double kRoot = std::pow(1.0 - k * k, 0.25);
+            const double e = 0.5 * (1.0 - kRoot) / (1.0 + kRoot);
+            const double e4 = e * e * e * e;
+            const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+            // Lowest odd order reaching the attenuation
+            const double attenuation = std::pow(10.0, -attenuationdB / 10.0);
+            const double a = attenuation / (1.0 - attenuation);
+            int order = static_cast<int>(std::ceil(std::log(a * a / 16.0) / std::log(q)));
+            order = std::max(3, order | 1);
+
+            const int numCoefficients = (order - 1) / 2;
+            std::vector<double> coefficients;
+
+            for (int c = 1; c <= numCoefficients; ++c)
+            {
+                double numerator = 0.0, denominator = 0.0;
+
+                for (int i = 0, sign = 1; ; ++i, sign = -sign)
+                {
+                    const double term = std::pow(q, i * (i + 1)) * std::sin((i * 2 + 1) * c * pi / order) * sign;
+                    numerator += term;
+                    if (std::abs(term) < 1.0e-100)
+                        break;
+                }
+
+                for (int i = 1, sign = -1; ; ++i, sign = -sign)
+                {
+                    const double term = std::pow(q, i * i) * std::cos(i * 2 * c * pi / order) * sign;
+                    denominator += term;
+                    if (std::abs(term) < 1.0e-100)
+                        break;
+                }
+
+                const double ww = numerator * 2.0 * std::pow(q, 0.25) / (denominator * 2.0 + 1.0);
+                const double wwSquared = ww * ww;
+                const double x = std::sqrt((1.0 - wwSquared * k) * (1.0 - wwSquared / k)) / (1.0 + wwSquared);
+                coefficients.push_back((1.0 - x) / (1.0 + x));
+            }
+
+            return coefficients;
+        }
+
+        // Delay at DC of a first-order allpass (a + z^-1) / (1 + a z^-1)
+        double getAllpassDelay(const std::vector<double>& path)
+        {
+            double delay = 0.0;
+            for (auto a : path)
+                delay += (1.0 - a) / (1.0 + a);
+            return delay;
+        }
+
+        //==============================================================================
+        // Equiripple half-band FIR (Remez exchange on the odd taps)
+
+        // Minimax fit of 0.5 by sum g_j 2cos((2j - 1)w) over the passband [0, passbandEdge];
+        // returns the taps and sets the peak error, which is also the stopband ripple
+        std::vector<double> designHalfBandTaps(int numTaps, double passbandEdge, double& peakError)
+        {
+            const int numExtrema = numTaps + 1;
+            const int columns = numExtrema + 1;
+            const int gridSize = numTaps * 32 + 1;
+
+            // Basis functions sampled over the grid
+            std::vector<double> basis(static_cast<size_t>(gridSize * numTaps));
+            for (int i = 0; i < gridSize; ++i)
+                for (int j = 0; j < numTaps; ++j)
+                    basis[static_cast<size_t>(i * numTaps + j)] = 2.0 * std::cos((2 * j + 1) * passbandEdge * i / (gridSize - 1));
+
+            // Initial extrema bunched towards the ends, where the ripples of the optimum crowd
+            std::vector<int> extrema(static_cast<size_t>(numExtrema));
+            for (int i = 0; i < numExtrema; ++i)
+                extrema[static_cast<size_t>(i)] = juce::roundToInt((gridSize - 1) * 0.5 * (1.0 - std::cos(juce::MathConstants<double>::pi * i / numTaps)));
+
+            std::vector<double> taps(static_cast<size_t>(numTaps));
+            std::vector<double> error(static_cast<size_t>(gridSize));
+            std::vector<long double> system(static_cast<size_t>(numExtrema * columns));
+            auto at = [&system, columns](int row, int column) -> long double& { return system[static_cast<size_t>(row * columns + column)]; };
+            auto sign = [&error](int i) { return error[static_cast<size_t>(i)] > 0.0; };
+
+            peakError = 1.0;
+
+            for (int iteration = 0; iteration < 1000; ++iteration)
+            {
+                // Taps and a levelled error alternating in sign over the extrema (Gauss-Jordan)
+                for (int row = 0; row < numExtrema; ++row)
+                {
+                    for (int j = 0; j < numTaps; ++j)
+                        at(row, j) = basis[static_cast<size_t>(extrema[static_cast<size_t>(row)] * numTaps + j)];
+                    at(row, numTaps) = (row & 1) != 0 ? -1.0L : 1.0L;
+                    at(row, numExtrema) = 0.5L;
+                }
+
+                for (int pivot = 0; pivot < numExtrema; ++pivot)
+                {
+                    int best = pivot;
+                    for (int row = pivot + 1; row < numExtrema; ++row)
+                        if (std::abs(at(row, pivot)) > std::abs(at(best, pivot)))
+                            best = row;
+
+                    for (int j = 0; j < columns && best != pivot; ++j)
+                        std::swap(at(best, j), at(pivot, j));
+
+                    for (int row = 0; row < numExtrema; ++row)
+                    {
+                        if (row == pivot)
+                            continue;
+
+                        const long double factor = at(row, pivot) / at(pivot, pivot);
+                        for (int j = pivot; j < columns; ++j)
+                            at(row, j) -= factor * at(pivot, j);
+                    }
+                }
+
+                for (int j = 0; j < numTaps; ++j)
+                    taps[static_cast<size_t>(j)] = static_cast<double>(at(j, numExtrema) / at(j, j));
+
+                const double levelled = std::abs(static_cast<double>(at(numTaps, numExtrema) / at(numTaps, numTaps)));
+
+                int worst = 0;
+                for (int i = 0; i < gridSize; ++i)
+                {
+                    double sum = 0.0;
+                    for (int j = 0; j < numTaps; ++j)
+                        sum += taps[static_cast<size_t>(j)] * basis[static_cast<size_t>(i * numTaps + j)];
+
+                    error[static_cast<size_t>(i)] = 0.5 - sum;
+                    if (std::abs(error[static_cast<size_t>(i)]) > std::abs(error[static_cast<size_t>(worst)]))
+                        worst = i;
+                }
+
+                peakError = std::abs(error[static_cast<size_t>(worst)]);
+                if (peakError - levelled <= 1.0e-9 * peakError)
+                    break;
+
+                // Multiple exchange: local peaks of |error|, one per run of equal sign
+                std::vector<int> peaks;
+                for (int i = 0; i < gridSize; ++i)
+                {
+                    const double e = std::abs(error[static_cast<size_t>(i)]);
+                    if ((i > 0 && e < std::abs(error[static_cast<size_t>(i - 1)]))
+                        || (i < gridSize - 1 && e < std::abs(error[static_cast<size_t>(i + 1)])))
+                        continue;
+
+                    if (!peaks.empty() && sign(peaks.back()) == sign(i))
+                    {
+                        if (e > std::abs(error[static_cast<size_t>(peaks.back())]))
+                            peaks.back() = i;
+                        continue;
+                    }
+
+                    peaks.push_back(i);
+                }
+
+                while (static_cast<int>(peaks.size()) > numExtrema)
+                {
+                    if (std::abs(error[static_cast<size_t>(peaks.front())]) < std::abs(error[static_cast<size_t>(peaks.back())]))
+                        peaks.erase(peaks.begin());
+                    else
+                        peaks.pop_back();
+                }
+
+                if (static_cast<int>(peaks.size()) == numExtrema && std::find(peaks.begin(), peaks.end(), worst) != peaks.end())
+                {
+                    extrema = peaks;
+                    continue;
+                }
+
+                // Too few clean peaks - single exchange of the worst point, keeping the alternation
+                if (std::find(extrema.begin(), extrema.end(), worst) != extrema.end())
+                    break;
+
+                const auto next = std::upper_bound(extrema.begin(), extrema.end(), worst);
+
+                if (next == extrema.begin())
+                {
+                    if (sign(extrema.front()) != sign(worst))
+                    {
+                        extrema.pop_back();
+                        extrema.insert(extrema.begin(), worst);
+                    }
+                    else
+                    {
+                        extrema.front() = worst;
+                    }
+                }
+                else if (next == extrema.end())
+                {
+                    if (sign(extrema.back()) != sign(worst))
+                    {
+                        extrema.erase(extrema.begin());
+                        extrema.push_back(worst);
+                    }
+                    else
+                    {
+                        extrema.back() = worst;
+                    }
+                }
+                else
+                {
+                    *(sign(*(next - 1)) == sign(worst) ? next - 1 : next) = worst;
+                }
+            }
+
+            return taps;
+        }
+
+        std::vector<double> designEquirippleHalfBand(double transitionWidth, double attenuationdB)
+        {
+            const double passbandEdge = juce::MathConstants<double>::twoPi * (0.25 - transitionWidth * 0.5);
+            const double ripple = std::pow(10.0, -attenuationdB / 20.0);
+
+            // Shortest half-band meeting the attenuation, searching up from just below the usual
+            // length estimate N = (A - 13) / (14.6 dF) with N = 4M - 1
+            const int estimate = static_cast<int>((attenuationdB - 13.0) / (14.6 * transitionWidth * 4.0));
+
+            for (int numTaps = juce::jlimit(1, maxTaps, estimate - 2); ; ++numTaps)
+            {
+                double peakError = 1.0;
+                auto taps = designHalfBandTaps(numTaps, passbandEdge, peakError);
+
+                if (peakError <= ripple || numTaps == maxTaps)
+                    return taps;
+            }
+        }
+
+        HalfBandStage designStage(OversamplingFilter design, int stageIndex)
+        {
+            HalfBandStage stage;
+            const double transitionWidth = getTransitionWidth(stageIndex);
+
+            if (design == OversamplingFilter::MinimumLatencyIIR)
+            {
+                // Coefficients alternate between the two polyphase paths
+                const auto coefficients = designAllpassHalfBand(transitionWidth, stopbandAttenuationdB);
+                for (size_t i = 0; i < coefficients.size(); ++i)
+                    stage.allpass[i & 1].push_back(coefficients[i]);
+
+                jassert(static_cast<int>(stage.allpass[0].size()) <= maxAllpassSections);
+                stage.upState.resize(2 * coefficients.size());
+                stage.downState.resize(2 * coefficients.size());
+            }
+            else
+            {
+                stage.taps = designEquirippleHalfBand(transitionWidth, stopbandAttenuationdB);
+
+                // Mirrored rings: 2M low-rate frames up, 4M high-rate frames down
+                const auto numTaps = stage.taps.size();
+                stage.upState.resize(2 * 2 * numTaps);
+                stage.downState.resize(2 * 4 * numTaps);
+            }
+
+            return stage;
+        }
+
+        // Round trip through stages [0, numStages) in top-rate samples; for the FIR design
+        // also picks each stage's decimation phase so the total divides down to the host rate
+        double getCascadeDelay(OversamplingFilter design, std::vector<HalfBandStage>& stages, int numStages)
+        {
+            double delay = 0.0;
+
+            for (int s = numStages - 1; s >= 0; --s)
+            {
+                const auto& stage = stages[static_cast<size_t>(s)];
+                const double weight = static_cast<double>(1 << (numStages - 1 - s));
+
+                if (design == OversamplingFilter::MinimumLatencyIIR)
+                {
+                    // Allpass paths delay by d0 and d1 low-rate samples, the pair by twice their sum
+                    delay += 2.0 * (getAllpassDelay(stage.allpass[0]) + getAllpassDelay(stage.allpass[1])) * weight;
+                    continue;
+                }
+
+                // Centre delay c = 2M - 1 each way, one less when decimating on the odd phase
+                const int centre = 2 * static_cast<int>(stage.taps.size()) - 1;
+                const auto total = static_cast<juce::int64>(delay);
+                const auto modulus = static_cast<juce::int64>(weight) * 2;
+                const auto evenTrip = static_cast<juce::int64>(2 * centre) * static_cast<juce::int64>(weight);
+
+                stages[static_cast<size_t>(s)].decimationPhase = (total + evenTrip) % modulus == 0 ? 0 : 1;
+                delay += static_cast<double>(2 * centre - stage.decimationPhase) * weight;
+            }
+
+            return delay;
+        }
+
+        //==============================================================================
+        // Frame access: planar channels at the host and top rates, interleaved between stages
+
+        template <typename Type>
+        struct PlanarFrames
+        {
+            Type* left;
+            Type* right;
+
+            DoublePair load(int i) const
+            {
+                alignas(16) double frame[2] = { static_cast<double>(left[i]), static_cast<double>(right[i]) };
+                return DoublePair::fromRawArray(frame);
+            }
+
+            void store(int i, DoublePair value) const
+            {
+                alignas(16) double frame[2];
+                value.copyToRawArray(frame);
+                left[i] = static_cast<Type>(frame[0]);
+                right[i] = static_cast<Type>(frame[1]);
+            }
+        };
+
+        struct InterleavedFrames
+        {
+            StereoFrame* frames;
+
+            DoublePair load(int i) const              { return DoublePair::fromRawArray(frames[i].lanes); }
+            void store(int i, DoublePair value) const { value.copyToRawArray(frames[i].lanes); }
+        };
+
+        inline DoublePair loadFrame(const StereoFrame& frame)              { return DoublePair::fromRawArray(frame.lanes); }
+        inline void storeFrame(StereoFrame& frame, DoublePair value)       { value.copyToRawArray(frame.lanes); }
+
+        // Appends a frame to a mirrored ring; the newest frames then sit contiguously before
+        // the returned pointer's position
+        inline StereoFrame* pushRing(std::vector<StereoFrame>& ring, int& position, DoublePair value)
+        {
+            const int length = static_cast<int>(ring.size()) / 2;
+            storeFrame(ring[static_cast<size_t>(position)], value);
+            storeFrame(ring[static_cast<size_t>(position + length)], value);
+            position = position + 1 == length ? 0 : position + 1;
+            return &ring[static_cast<size_t>(position + length - 1)];
+        }
+
+        //==============================================================================
+        // Allpass chains with the state held in registers for the whole block
+
+        struct AllpassPaths
+        {
+            DoublePair a[2][maxAllpassSections], x1[2][maxAllpassSections], y1[2][maxAllpassSections];
+            int count[2];
+
+            AllpassPaths(const HalfBandStage& stage, const std::vector<StereoFrame>& state)
+            {
+                for (int path = 0, k = 0; path < 2; ++path)
+                {
+                    count[path] = static_cast<int>(stage.allpass[path].size());
+
+                    for (int s = 0; s < count[path]; ++s, ++k)
+                    {
+                        a[path][s] = DoublePair::expand(stage.allpass[path][static_cast<size_t>(s)]);
+                        x1[path][s] = loadFrame(state[static_cast<size_t>(2 * k)]);
+                        y1[path][s] = loadFrame(state[static_cast<size_t>(2 * k + 1)]);
+                    }
+                }
+            }
+
+            void save(std::vector<StereoFrame>& state) const
+            {
+                for (int path = 0, k = 0; path < 2; ++path)
+                {
+                    for (int s = 0; s < count[path]; ++s, ++k)
+                    {
+                        storeFrame(state[static_cast<size_t>(2 * k)], x1[path][s]);
+                        storeFrame(state[static_cast<size_t>(2 * k + 1)], y1[path][s]);
+                    }
+                }
+            }
+
+            DoublePair run(int path, DoublePair x)
+            {
+                for (int s = 0; s < count[path]; ++s)
+                {
+                    const auto y = a[path][s] * (x - y1[path][s]) + x1[path][s];
+                    x1[path][s] = x;
+                    y1[path][s] = y;
+                    x = y;
+                }
+
+                return x;
+            }
+        };
+    }
+
+    template <typename SampleType>
+    PolyphaseOversampler<SampleType>::PolyphaseOversampler(OversamplingFilter filterDesign)
+        : design(filterDesign)
+    {
+        for (int s = 0; s < maxStages; ++s)
+        {
+            stages.push_back(designStage(design, s));
+
+            if (s > 0)
+                intermediate[s].resize(static_cast<size_t>(chunkSize << s));
+        }
+
+        oversampledBuffer.setSize(2, chunkSize << maxStages);
+    }
+
+    template <typename SampleType>
+    void PolyphaseOversampler<SampleType>::setNumStages(int newNumStages)
+    {
+        numStages = juce::jlimit(0, maxStages, newNumStages);
+
+        const double delay = getCascadeDelay(design, stages, numStages);
+        latencySamples = juce::roundToInt(delay / static_cast<double>(1 << numStages));
+        reset();
+    }
+
+    template <typename SampleType>
+    void PolyphaseOversampler<SampleType>::reset()
+    {
+        for (auto& stage : stages)
+        {
+            std::fill(stage.upState.begin(), stage.upState.end(), StereoFrame {});
+            std::fill(stage.downState.begin(), stage.downState.end(), StereoFrame {});
+            stage.upPosition = stage.downPosition = 0;
+        }
+    }
+
+    template <typename SampleType>
+    int PolyphaseOversampler<SampleType>::getLatencySamples(int stagesToMeasure) const
+    {
+        // Works on a copy so the live decimation phases stay as they are
+        auto scratch = stages;
+        const int count = juce::jlimit(0, maxStages, stagesToMeasure);
+        return juce::roundToInt(getCascadeDelay(design, scratch, count) / static_cast<double>(1 << count));
+    }
+
+    template <typename SampleType>
+    juce::dsp::AudioBlock<SampleType> PolyphaseOversampler<SampleType>::upsampleChunk(const juce::dsp::AudioBlock<SampleType>& chunk)
+    {
+        jassert(chunk.getNumChannels() >= 2 && chunk.getNumSamples() <= static_cast<size_t>(chunkSize));
+
+        const int numSamples = static_cast<int>(chunk.getNumSamples());
+        const PlanarFrames<SampleType> host { chunk.getChannelPointer(0), chunk.getChannelPointer(1) };
+        const PlanarFrames<SampleType> top { oversampledBuffer.getWritePointer(0), oversampledBuffer.getWritePointer(1) };
+        juce::dsp::AudioBlock<SampleType> oversampled(oversampledBuffer);
+
+        if (numStages == 0)
+            return oversampled.getSubBlock(0, 0);
+
+        for (int s = 0; s < numStages; ++s)
+        {
+            auto& stage = stages[static_cast<size_t>(s)];
+            const int numInput = numSamples << s;
+            const bool first = s == 0;
+            const bool last = s == numStages - 1;
+
+            if (first && last)
+                upsampleStage(stage, host, top, numInput);
+            else if (first)
+                upsampleStage(stage, host, InterleavedFrames { intermediate[1].data() }, numInput);
+            else if (last)
+                upsampleStage(stage, InterleavedFrames { intermediate[s].data() }, top, numInput);
+            else
+                upsampleStage(stage, InterleavedFrames { intermediate[s].data() }, InterleavedFrames { intermediate[s + 1].data() }, numInput);
+        }
+
+        return oversampled.getSubBlock(0, static_cast<size_t>(numSamples << numStages));
+    }
+
+    template <typename SampleType>
+    void PolyphaseOversampler<SampleType>::downsampleChunk(const juce::dsp::AudioBlock<SampleType>& chunk)
+    {
+        const int numSamples = static_cast<int>(chunk.getNumSamples());
+        const PlanarFrames<SampleType> host { chunk.getChannelPointer(0), chunk.getChannelPointer(1) };
+        const PlanarFrames<SampleType> top { oversampledBuffer.getWritePointer(0), oversampledBuffer.getWritePointer(1) };
+
+        // Top stage first; its planar input is the saturated output straight from the buffer
+        for (int s = numStages - 1; s >= 0; --s)
+        {
+            auto& stage = stages[static_cast<size_t>(s)];
+            const int numOutput = numSamples << s;
+            const bool first = s == numStages - 1;
+            const bool last = s == 0;
+
+            if (first && last)
+                downsampleStage(stage, top, host, numOutput);
+            else if (first)
+                downsampleStage(stage, top, InterleavedFrames { intermediate[s].data() }, numOutput);
+            else if (last)
+                downsampleStage(stage, InterleavedFrames { intermediate[1].data() }, host, numOutput);
+            else
+                downsampleStage(stage, InterleavedFrames { intermediate[s + 1].data() }, InterleavedFrames { intermediate[s].data() }, numOutput);
+        }
+    }
+
+    template <typename SampleType>
+    template <typename Source, typename Destination>
+    void PolyphaseOversampler<SampleType>::upsampleStage(HalfBandStage& stage, const Source& input,
+                                                         const Destination& output, int numInput) const
+    {
+        if (design == OversamplingFilter::MinimumLatencyIIR)
+        {
+            // Even outputs from one allpass path, odd outputs from the other
+            AllpassPaths paths(stage, stage.upState);
+
+            for (int i = 0; i < numInput; ++i)
+            {
+                const auto x = input.load(i);
+                output.store(2 * i, paths.run(0, x));
+                output.store(2 * i + 1, paths.run(1, x));
+            }
+
+            paths.save(stage.upState);
+            return;
+        }
+
+        // Even outputs are the symmetric tap pairs (gain 2 for the zero-stuffing), odd outputs
+        // the centre tap - a plain delay of M - 1 input frames
+        const int numTaps = static_cast<int>(stage.taps.size());
+        DoublePair taps[maxTaps];
+        for (int j = 0; j < numTaps; ++j)
+            taps[j] = DoublePair::expand(2.0 * stage.taps[static_cast<size_t>(j)]);
+
+        for (int i = 0; i < numInput; ++i)
+        {
+            const auto* newest = pushRing(stage.upState, stage.upPosition, input.load(i));
+            auto sum = DoublePair::expand(0.0);
+
+            for (int j = 0; j < numTaps; ++j)
+                sum = sum + taps[j] * (loadFrame(newest[-(numTaps - 1 - j)]) + loadFrame(newest[-(numTaps + j)]));
+
+            output.store(2 * i, sum);
+            output.store(2 * i + 1, loadFrame(newest[-(numTaps - 1)]));
+        }
+    }
+
+    template <typename SampleType>
+    template <typename Source, typename Destination>
+    void PolyphaseOversampler<SampleType>::downsampleStage(HalfBandStage& stage, const Source& input,
+                                                           const Destination& output, int numOutput) const
+    {
+        const auto half = DoublePair::expand(0.5);
+
+        if (design == OversamplingFilter::MinimumLatencyIIR)
+        {
+            AllpassPaths paths(stage, stage.downState);
+
+            for (int i = 0; i < numOutput; ++i)
+                output.store(i, half * (paths.run(0, input.load(2 * i + 1)) + paths.run(1, input.load(2 * i))));
+
+            paths.save(stage.downState);
+            return;
+        }
+
+        // Only every other output is computed; the centre tap lands on the other phase
+        const int numTaps = static_cast<int>(stage.taps.size());
+        const int centre = 2 * numTaps - 1 + (1 - stage.decimationPhase);
+        DoublePair taps[maxTaps];
+        for (int j = 0; j < numTaps; ++j)
+            taps[j] = DoublePair::expand(stage.taps[static_cast<size_t>(j)]);
+
+        for (int i = 0; i < numOutput; ++i)
+        {
+            pushRing(stage.downState, stage.downPosition, input.load(2 * i));
+            const auto* newest = pushRing(stage.downState, stage.downPosition, input.load(2 * i + 1));
+            auto sum = half * loadFrame(newest[-centre]);
+
+            for (int j = 0; j < numTaps; ++j)
+                sum = sum + taps[j] * (loadFrame(newest[-(centre - 2 * j - 1)]) + loadFrame(newest[-(centre + 2 * j + 1)]));
+
+            output.store(i, sum);
+        }
+    }
+
+    template class PolyphaseOversampler<float>;
+    template class PolyphaseOversampler<double>;
+}
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    PolyphaseOversampler - Stereo Half-Band Resampler for the Saturation Stage
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace Aetheri
+{
+    // Half-band filter design used by every stage of the resampler
+    enum class OversamplingFilter
+    {
+        MinimumLatencyIIR = 0,  // Polyphase allpass pairs - short, frequency-dependent delay
+        LinearPhaseFIR          // Equiripple half-band FIRs - constant delay, no phase shift
+    };
+
+    // One stereo frame, a 64-bit SIMD register's worth
+    struct alignas(16) StereoFrame
+    {
+        double lanes[2];
+    };
+
+    // One 2x stage of the resampler: its half-band design and both directions' state
+    struct HalfBandStage
+    {
+        // IIR: allpass coefficients of the two polyphase paths
+        std::vector<double> allpass[2];
+        // FIR: non-zero side taps of the half-band, nearest the centre first
+        std::vector<double> taps;
+
+        // FIR decimation keeps the output lined up with the odd (1) or even (0) input of
+        // each pair, chosen so the cascade's delay is a whole number of host samples
+        int decimationPhase = 1;
+
+        // IIR: x1/y1 per allpass section; FIR: mirrored history rings
+        std::vector<StereoFrame> upState, downState;
+        int upPosition = 0;
+        int downPosition = 0;
+    };
+
+    /**
+     * Stereo polyphase resampler for the saturation stage
+     * A cascade of up to four 2x half-band stages (16x), each channel in one lane of a
+     * double x2 SIMD register. Blocks run through in short chunks, so the saturated
+     * oversampled signal is decimated while it is still in cache
+     */
+    template <typename SampleType>
+    class PolyphaseOversampler
+    {
+    public:
+        static constexpr int maxStages = 4;   // 2x, 4x, 8x, 16x
+        static constexpr int chunkSize = 64;  // Host-rate samples per pass through the stages
+
+        // Designs every stage and allocates the buffers - not real-time safe
+        explicit PolyphaseOversampler(OversamplingFilter filterDesign);
+
+        OversamplingFilter getDesign() const { return design; }
+
+        // Number of active stages (0 = off); clears the filter state
+        void setNumStages(int newNumStages);
+        int getNumStages() const { return numStages; }
+        int getFactor() const { return 1 << numStages; }
+
+        void reset();
+
+        // Host-rate delay of an up/down round trip through the given number of stages
+        // (rounded for the IIR design, whose delay varies with frequency)
+        int getLatencySamples(int stagesToMeasure) const;
+        int getLatencySamples() const { return latencySamples; }
+
+        // Runs processOversampled on the block at the oversampled rate, in place on the
+        // resampler's buffer one chunk at a time, and decimates the result back into the block
+        template <typename Processor>
+        void process(const juce::dsp::AudioBlock<SampleType>& block, Processor&& processOversampled)
+        {
+            const auto numSamples = block.getNumSamples();
+
+            if (numStages == 0)
+            {
+                processOversampled(block);
+                return;
+            }
+
+            for (size_t start = 0; start < numSamples; start += chunkSize)
+            {
+                const auto chunk = block.getSubBlock(start, std::min(static_cast<size_t>(chunkSize), numSamples - start));
+                processOversampled(upsampleChunk(chunk));
+                downsampleChunk(chunk);
+            }
+        }
+
+    private:
+        OversamplingFilter design;
+        std::vector<HalfBandStage> stages;
+        int numStages = 0;
+        int latencySamples = 0;
+
+        // Frames between stages at 2x ... 8x; the top rate lives in oversampledBuffer
+        std::vector<StereoFrame> intermediate[maxStages];
+        juce::AudioBuffer<SampleType> oversampledBuffer;
+
+        juce::dsp::AudioBlock<SampleType> upsampleChunk(const juce::dsp::AudioBlock<SampleType>& chunk);
+        void downsampleChunk(const juce::dsp::AudioBlock<SampleType>& chunk);
+
+        template <typename Source, typename Destination>
+        void upsampleStage(HalfBandStage& stage, const Source& input, const Destination& output, int numInput) const;
+        template <typename Source, typename Destination>
+        void downsampleStage(HalfBandStage& stage, const Source& input, const Destination& output, int numOutput) const;
+
+        JUCE_DECLARE_NON_COPYABLE(PolyphaseOversampler)
+    };
+}
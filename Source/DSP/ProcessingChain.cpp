@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    ProcessingChain Implementation
+  ==============================================================================
+*/
+
+#include "ProcessingChain.h"
+
+namespace Aetheri
+{
+    //==============================================================================
+    // ProcessingChain Implementation
+    //==============================================================================
+    
+    ProcessingChain::ProcessingChain(FilterSection& filters, PassiveEQ& eq, HysteresisProcessor& hyst)
+        : filterSection(filters), passiveEQ(eq), hysteresis(hyst)
+    {
+    }
+    
+    bool ProcessingChain::rebuild()
+    {
+        juce::uint32 newMask = 0;
+        
+        // The linear-phase EQ renders HPF/LPF inside its own FIR
+        const bool foldFilters = passiveEQ.getEngine() == PassiveEQ::Engine::LinearPhase;
+        
+        if (foldFilters)
+        {
+            passiveEQ.setFoldedFilters(filterSection.getHPF().getTargetCoefficients(),
+                                       filterSection.getLPF().getTargetCoefficients());
+            newMask |= foldedFiltersBit;
+        }
+        else
+        {
+            if (!filterSection.getHPF().isNeutral())  newMask |= bitFor(Stage::HighPass);
+            if (!filterSection.getLPF().isNeutral())  newMask |= bitFor(Stage::LowPass);
+        }
+        
+        if (!passiveEQ.isNeutral())               newMask |= bitFor(Stage::EQ);
+        if (!hysteresis.isNeutral())              newMask |= bitFor(Stage::Hysteresis);
+        
+        if (newMask == stageMask)
+            return false;
+        
+        // Filter history went stale while the FIR carried the filters
+        if (stageMask != invalidMask && (stageMask & ~newMask & foldedFiltersBit) != 0)
+            filterSection.reset();
+        
+        // Saturation state went stale while the stage was skipped
+        if (stageMask != invalidMask && (newMask & ~stageMask & bitFor(Stage::Hysteresis)) != 0)
+            hysteresis.resume();
+        
+        stageMask = newMask;
+        numStages = 0;
+        
+        for (auto stage : { Stage::HighPass, Stage::LowPass, Stage::EQ, Stage::Hysteresis })
+        {
+            if ((stageMask & bitFor(stage)) != 0)
+                stages[static_cast<size_t>(numStages++)] = stage;
+        }
+        
+        return true;
+    }
+    
+    void ProcessingChain::setChannelsIdentical(bool identical)
+    {
+        // The right channel's state stood still while only the left one ran
+        if (channelsIdentical && !identical)
+        {
+            filterSection.copyChannelState(0, 1);
+            hysteresis.copyChannelState(0, 1);
+        }
+        
+        channelsIdentical = identical;
+    }
+    
+    template <typename SampleType>
+    void ProcessingChain::process(const juce::dsp::ProcessContextReplacing<SampleType>& context)
+    {
+        processLinear(context);
+        processSaturation(context);
+    }
+    
+    template <typename SampleType>
+    void ProcessingChain::processLinear(const juce::dsp::ProcessContextReplacing<SampleType>& context)
+    {
+        const auto& block = context.getOutputBlock();
+        const auto filterBlock = channelsIdentical ? block.getSingleChannelBlock(0) : block;
+        bool filtered = false;
+        
+        // The filters come first, on the left channel alone when both match; the EQ and
+        // whatever follows get both channels back
+        auto restoreRight = [&]
+        {
+            if (channelsIdentical && filtered)
+                block.getSingleChannelBlock(1).copyFrom(filterBlock);
+            filtered = false;
+        };
+        
+        for (int i = 0; i < numStages; ++i)
+        {
+            switch (stages[static_cast<size_t>(i)])
+            {
+                case Stage::HighPass:   filterSection.getHPF().processBlock(filterBlock); filtered = true; break;
+                case Stage::LowPass:    filterSection.getLPF().processBlock(filterBlock); filtered = true; break;
+                case Stage::EQ:         restoreRight(); passiveEQ.processBlock(block); break;
+                case Stage::Hysteresis: break;
+            }
+        }
+        
+        restoreRight();
+        
+        // The skipped EQ still follows the signal at its position in the chain
+        if ((stageMask & bitFor(Stage::EQ)) == 0)
+            passiveEQ.trackSkippedInput(block);
+    }
+    
+    template <typename SampleType>
+    void ProcessingChain::processSaturation(const juce::dsp::ProcessContextReplacing<SampleType>& context)
+    {
+        if (!hasSaturation())
+            return;
+        
+        const auto& block = context.getOutputBlock();
+        
+        if (channelsIdentical && block.getNumChannels() > 1)
+        {
+            hysteresis.processBlock(block.getSingleChannelBlock(0));
+            block.getSingleChannelBlock(1).copyFrom(block.getSingleChannelBlock(0));
+        }
+        else
+        {
+            hysteresis.processBlock(block);
+        }
+    }
+    
+    //==============================================================================
+    // LatencyMatchedBypass Implementation
+    //==============================================================================
+    
+    template <typename SampleType>
+    void LatencyMatchedBypass<SampleType>::prepare(int numChannels, int maxBlockSize, int maxLatencySamples, int historySamples)
+    {
+        maxLatency = latency = std::max(0, maxLatencySamples);
+        int historyLength = maxLatency > 0 ? std::max(0, historySamples) : 0;
+        
+        if (maxLatency == 0)
+        {
+            ring.setSize(0, 0);
+            history.setSize(0, 0);
+            ringMask = 0;
+        }
+        else
+        {
+            int ringSize = juce::nextPowerOfTwo(maxBlockSize + std::max(maxLatency, historyLength) + 1);
+            ring.setSize(numChannels, ringSize);
+            history.setSize(numChannels, historyLength);
+            ringMask = ringSize - 1;
+        }
+        
+        reset();
+    }
+    
+    template <typename SampleType>
+    void LatencyMatchedBypass<SampleType>::setLatency(int latencySamples)
+    {
+        jassert(latencySamples <= maxLatency);
+        latency = juce::jlimit(0, maxLatency, latencySamples);
+    }
+    
+    template <typename SampleType>
+    void LatencyMatchedBypass<SampleType>::reset()
+    {
+        ring.clear();
+        history.clear();
+        writePosition = 0;
+        lastBlockSize = 0;
+    }
+    
+    template <typename SampleType>
+    void LatencyMatchedBypass<SampleType>::pushInput(const juce::AudioBuffer<SampleType>& buffer)
+    {
+        // Kept current at zero delay too, in case the latency grows again
+        if (maxLatency == 0)
+            return;
+        
+        int numSamples = buffer.getNumSamples();
+        jassert(numSamples + maxLatency <= ring.getNumSamples());
+        
+        int numChannels = std::min(buffer.getNumChannels(), ring.getNumChannels());
+        int first = std::min(numSamples, ring.getNumSamples() - writePosition);
+        
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            ring.copyFrom(ch, writePosition, buffer, ch, 0, first);
+            
+            if (first < numSamples)
+                ring.copyFrom(ch, 0, buffer, ch, first, numSamples - first);
+        }
+        
+        writePosition = (writePosition + numSamples) & ringMask;
+        lastBlockSize = numSamples;
+    }
+    
+    template <typename SampleType>
+    void LatencyMatchedBypass<SampleType>::readRing(juce::AudioBuffer<SampleType>& dest, int destSamples, int startPosition) const
+    {
+        int numChannels = std::min(dest.getNumChannels(), ring.getNumChannels());
+        int start = startPosition & ringMask;
+        int first = std::min(destSamples, ring.getNumSamples() - start);
+        
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            dest.copyFrom(ch, 0, ring, ch, start, first);
+            
+            if (first < destSamples)
+                dest.copyFrom(ch, first, ring, ch, 0, destSamples - first);
+        }
+    }
+    
+    template <typename SampleType>
+    void LatencyMatchedBypass<SampleType>::processDelayed(juce::AudioBuffer<SampleType>& buffer) const
+    {
+        if (latency == 0)
+            return;
+        
+        int numSamples = buffer.getNumSamples();
+        readRing(buffer, numSamples, writePosition - numSamples - latency);
+    }
+    
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& LatencyMatchedBypass<SampleType>::getHistory()
+    {
+        int historyLength = history.getNumSamples();
+        
+        if (historyLength > 0)
+            readRing(history, historyLength, writePosition - lastBlockSize - historyLength);
+        
+        return history;
+    }
+    
+    template void ProcessingChain::process<float>(const juce::dsp::ProcessContextReplacing<float>&);
+    template void ProcessingChain::process<double>(const juce::dsp::ProcessContextReplacing<double>&);
+    template void ProcessingChain::processLinear<float>(const juce::dsp::ProcessContextReplacing<float>&);
+    template void ProcessingChain::processLinear<double>(const juce::dsp::ProcessContextReplacing<double>&);
+    template void ProcessingChain::processSaturation<float>(const juce::dsp::ProcessContextReplacing<float>&);
+    template void ProcessingChain::processSaturation<double>(const juce::dsp::ProcessContextReplacing<double>&);
+    
+    template class LatencyMatchedBypass<float>;
+    template class LatencyMatchedBypass<double>;
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    ProcessingChain - Compiled Stage List with Neutral-Stage Elimination
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <juce_core/juce_core.h>
+#include "HighLowPassFilters.h"
+#include "PassiveEQ.h"
+#include "HysteresisProcessor.h"
+
+namespace Aetheri
+{
+    /**
+     * The processing graph HPF -> LPF -> EQ -> Hysteresis, holding only the stages
+     * that currently change the signal
+     * rebuild() is cheap and runs once per block; the stage list is only recompiled
+     * when the set of live stages actually changes
+     * The linear stages run at the host rate; only the saturation is worth oversampling,
+     * so it is run separately at whatever rate the caller resamples to
+     */
+    class ProcessingChain
+    {
+    public:
+        enum class Stage { HighPass, LowPass, EQ, Hysteresis };
+        static constexpr int MaxStages = 4;
+        
+        ProcessingChain(FilterSection& filters, PassiveEQ& eq, HysteresisProcessor& hysteresis);
+        
+        // Forces a full recompile on the next rebuild()
+        void invalidate() { stageMask = invalidMask; }
+        
+        // Returns true if the stage list changed
+        bool rebuild();
+        
+        // Every live stage at one rate
+        template <typename SampleType>
+        void process(const juce::dsp::ProcessContextReplacing<SampleType>& context);
+        
+        // HPF/LPF and EQ, at the host rate
+        template <typename SampleType>
+        void processLinear(const juce::dsp::ProcessContextReplacing<SampleType>& context);
+        
+        // Hysteresis, in place on the context's block - the resampler's own memory when oversampling
+        template <typename SampleType>
+        void processSaturation(const juce::dsp::ProcessContextReplacing<SampleType>& context);
+        
+        // Set per block when both channels carry the same signal through identical settings:
+        // the per-channel HPF/LPF and hysteresis then run on the left channel and copy it
+        // across, and the right channel takes over their state when that ends. The EQ keeps
+        // both channels in one SIMD register either way
+        void setChannelsIdentical(bool identical);
+        bool areChannelsIdentical() const { return channelsIdentical; }
+
+        
+        bool isNeutral() const { return numStages == 0; }
+        bool hasSaturation() const { return (stageMask & bitFor(Stage::Hysteresis)) != 0 && stageMask != invalidMask; }
+        int getNumStages() const { return numStages; }
+        
+    private:
+        FilterSection& filterSection;
+        PassiveEQ& passiveEQ;
+        HysteresisProcessor& hysteresis;
+        
+        static constexpr juce::uint32 invalidMask = 0xffffffffu;
+        static constexpr juce::uint32 foldedFiltersBit = 1u << MaxStages;
+        
+        std::array<Stage, MaxStages> stages {};
+        int numStages = 0;
+        juce::uint32 stageMask = invalidMask;
+        bool channelsIdentical = false;
+        
+        static juce::uint32 bitFor(Stage stage) { return 1u << static_cast<int>(stage); }
+        
+        JUCE_DECLARE_NON_COPYABLE(ProcessingChain)
+    };
+    
+    /**
+     * Delay path used while the oversampled saturation is skipped
+     * Delays the signal by the resampler's latency so the host's delay compensation still
+     * lines up, and keeps a short history for re-priming the resampler when the
+     * saturation resumes
+     * The ring is sized for the longest latency up front, so the delay can follow a
+     * resampler switch on the audio thread
+     */
+    template <typename SampleType>
+    class LatencyMatchedBypass
+    {
+    public:
+        LatencyMatchedBypass() = default;
+        
+        void prepare(int numChannels, int maxBlockSize, int maxLatencySamples, int historySamples);
+        void reset();
+        
+        // Any delay up to the prepared maximum, without reallocating
+        void setLatency(int latencySamples);
+        int getLatency() const { return latency; }
+        
+        // Call once per block with the unprocessed input (no-op with nothing to track)
+        void pushInput(const juce::AudioBuffer<SampleType>& buffer);
+        
+        // Replaces the buffer with the pushed input delayed by the latency
+        void processDelayed(juce::AudioBuffer<SampleType>& buffer) const;
+        
+        // The input that preceded the most recently pushed block
+        juce::AudioBuffer<SampleType>& getHistory();
+        
+    private:
+        juce::AudioBuffer<SampleType> ring;
+        juce::AudioBuffer<SampleType> history;
+        int ringMask = 0;
+        int writePosition = 0;
+        int lastBlockSize = 0;
+        int latency = 0;
+        int maxLatency = 0;
+        
+        void readRing(juce::AudioBuffer<SampleType>& dest, int destSamples, int startPosition) const;
+    };
+}
@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    StereoBiquadKernel Implementation
+  ==============================================================================
+*/
+
+#include "StereoBiquadKernel.h"
+
+namespace Aetheri
+{
+    namespace
+    {
+       #if JUCE_USE_SIMD
+        using DoublePair = juce::dsp::SIMDRegister<double>;
+       #else
+        // Scalar stand-in with the subset of the SIMDRegister interface used below
+        struct DoublePair
+        {
+            static constexpr size_t SIMDNumElements = 2;
+            double v[2];
+
+            static DoublePair expand(double s) noexcept                 { return { { s, s } }; }
+            static DoublePair fromRawArray(const double* a) noexcept    { return { { a[0], a[1] } }; }
+            void copyToRawArray(double* a) const noexcept               { a[0] = v[0]; a[1] = v[1]; }
+            static DoublePair abs(DoublePair a) noexcept                { return { { std::abs(a.v[0]), std::abs(a.v[1]) } }; }
+
+            DoublePair operator+(DoublePair o) const noexcept { return { { v[0] + o.v[0], v[1] + o.v[1] } }; }
+            DoublePair operator-(DoublePair o) const noexcept { return { { v[0] - o.v[0], v[1] - o.v[1] } }; }
+            DoublePair operator*(DoublePair o) const noexcept { return { { v[0] * o.v[0], v[1] * o.v[1] } }; }
+        };
+       #endif
+
+        static_assert(DoublePair::SIMDNumElements == StereoBiquadKernel::NumLanes,
+                      "StereoBiquadKernel expects one channel per 64-bit SIMD lane");
+    }
+
+    StereoBiquadKernel::Coefficients StereoBiquadKernel::makeUnityCoefficients()
+    {
+        Coefficients unity {};
+
+        for (int band = 0; band < NumBands; ++band)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane)
+                unity.b0[band][lane] = 1.0;
+        }
+
+        return unity;
+    }
+
+    void StereoBiquadKernel::reset()
+    {
+        state = {};
+    }
+
+    void StereoBiquadKernel::setBandCoefficients(int band, int lane, const BiquadCoefficients& c)
+    {
+        jassert(band >= 0 && band < NumBands && lane >= 0 && lane < NumLanes);
+
+        coeffs.b0[band][lane] = c.b0;
+        coeffs.b1[band][lane] = c.b1;
+        coeffs.b2[band][lane] = c.b2;
+        coeffs.a1[band][lane] = c.a1;
+        coeffs.a2[band][lane] = c.a2;
+
+        bypassed[band][lane] = false;
+        clearRamp(band, lane, c);
+    }
+
+    void StereoBiquadKernel::setBandBypassed(int band, int lane)
+    {
+        // Unity section - the signal passes through
+        setBandCoefficients(band, lane, BiquadCoefficients {});
+        bypassed[band][lane] = true;
+    }
+
+    void StereoBiquadKernel::rampBandCoefficients(int band, int lane, const BiquadCoefficients& target, int numSamples)
+    {
+        jassert(band >= 0 && band < NumBands && lane >= 0 && lane < NumLanes);
+
+        if (numSamples <= 1)
+        {
+            setBandCoefficients(band, lane, target);
+            return;
+        }
+
+        // A bypassed band holds unity coefficients, so it glides in from flat
+        bypassed[band][lane] = false;
+
+        const double scale = 1.0 / numSamples;
+        ramp.b0[band][lane] = (target.b0 - coeffs.b0[band][lane]) * scale;
+        ramp.b1[band][lane] = (target.b1 - coeffs.b1[band][lane]) * scale;
+        ramp.b2[band][lane] = (target.b2 - coeffs.b2[band][lane]) * scale;
+        ramp.a1[band][lane] = (target.a1 - coeffs.a1[band][lane]) * scale;
+        ramp.a2[band][lane] = (target.a2 - coeffs.a2[band][lane]) * scale;
+        ramp.target[band][lane] = target;
+
+        ramping = ramping || ramp.b0[band][lane] != 0.0 || ramp.b1[band][lane] != 0.0
+                          || ramp.b2[band][lane] != 0.0 || ramp.a1[band][lane] != 0.0
+                          || ramp.a2[band][lane] != 0.0;
+    }
+
+    bool StereoBiquadKernel::isBandUnity(int band, int lane) const
+    {
+        const auto& target = ramp.target[band][lane];
+        return coeffs.b0[band][lane] == 1.0 && coeffs.b1[band][lane] == 0.0 && coeffs.b2[band][lane] == 0.0
+            && coeffs.a1[band][lane] == 0.0 && coeffs.a2[band][lane] == 0.0 && target.isUnity()
+            && state.z1[band][lane] == state.z1[band + 1][lane] && state.z2[band][lane] == state.z2[band + 1][lane];
+    }
+
+    void StereoBiquadKernel::setHistory(const double* previousFrame, const double* lastFrame)
+    {
+        // Identity history: every section's input and output saw the same signal
+        for (int i = 0; i <= NumBands; ++i)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane)
+            {
+                state.z1[i][lane] = lastFrame[lane];
+                state.z2[i][lane] = previousFrame[lane];
+            }
+        }
+    }
+
+    void StereoBiquadKernel::getSectionStates(SectionState (&states)[NumBands][NumLanes]) const
+    {
+        // Skipped bands have their history forwarded, so every band reads its own input here
+        for (int band = 0; band < NumBands; ++band)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane)
+            {
+                const BiquadCoefficients c { coeffs.b0[band][lane], coeffs.b1[band][lane], coeffs.b2[band][lane],
+                                             coeffs.a1[band][lane], coeffs.a2[band][lane] };
+                states[band][lane] = SectionState::fromDirectForm(c, state.z1[band][lane], state.z2[band][lane],
+                                                                  state.z1[band + 1][lane], state.z2[band + 1][lane]);
+            }
+        }
+    }
+
+    void StereoBiquadKernel::setSectionStates(const SectionState (&states)[NumBands][NumLanes],
+                                              const double* previousFrame, const double* lastFrame)
+    {
+        // Band by band along the cascade: each band's output history is the next one's input
+        for (int lane = 0; lane < NumLanes; ++lane)
+        {
+            state.z1[0][lane] = lastFrame[lane];
+            state.z2[0][lane] = previousFrame[lane];
+
+            for (int band = 0; band < NumBands; ++band)
+            {
+                const BiquadCoefficients c { coeffs.b0[band][lane], coeffs.b1[band][lane], coeffs.b2[band][lane],
+                                             coeffs.a1[band][lane], coeffs.a2[band][lane] };
+                states[band][lane].toDirectForm(c, state.z1[band][lane], state.z2[band][lane],
+                                                state.z1[band + 1][lane], state.z2[band + 1][lane]);
+            }
+        }
+    }
+
+    void StereoBiquadKernel::clearRamp(int band, int lane, const BiquadCoefficients& c)
+    {
+        ramp.b0[band][lane] = ramp.b1[band][lane] = ramp.b2[band][lane] = 0.0;
+        ramp.a1[band][lane] = ramp.a2[band][lane] = 0.0;
+        ramp.target[band][lane] = c;
+    }
+
+    template <typename SampleType>
+    void StereoBiquadKernel::processBlock(SampleType* left, SampleType* right, int numSamples)
+    {
+        // Only sections that are live in at least one lane run; a skipped section is an
+        // identity, so its input and output history stay equal and are forwarded below
+        int activeBands[NumBands];
+        int inputIndex[NumBands];
+        int numActive = 0;
+        int lastBoundary = 0;
+
+        for (int band = 0; band < NumBands; ++band)
+        {
+            if (bypassed[band][0] && bypassed[band][1])
+                continue;
+
+            activeBands[numActive] = band;
+            inputIndex[numActive] = lastBoundary;
+            lastBoundary = band + 1;
+            ++numActive;
+        }
+
+        // Pull coefficients and state into registers for the whole block
+        DoublePair b0[NumBands], b1[NumBands], b2[NumBands], a1[NumBands], a2[NumBands];
+        DoublePair z1[NumBands + 1], z2[NumBands + 1];
+
+        for (int k = 0; k < numActive; ++k)
+        {
+            const int band = activeBands[k];
+            b0[k] = DoublePair::fromRawArray(coeffs.b0[band]);
+            b1[k] = DoublePair::fromRawArray(coeffs.b1[band]);
+            b2[k] = DoublePair::fromRawArray(coeffs.b2[band]);
+            a1[k] = DoublePair::fromRawArray(coeffs.a1[band]);
+            a2[k] = DoublePair::fromRawArray(coeffs.a2[band]);
+        }
+
+        for (int i = 0; i <= NumBands; ++i)
+        {
+            z1[i] = DoublePair::fromRawArray(state.z1[i]);
+            z2[i] = DoublePair::fromRawArray(state.z2[i]);
+        }
+
+        DoublePair db0[NumBands], db1[NumBands], db2[NumBands], da1[NumBands], da2[NumBands];
+        const bool glide = ramping;
+
+        if (glide)
+        {
+            for (int k = 0; k < numActive; ++k)
+            {
+                const int band = activeBands[k];
+                db0[k] = DoublePair::fromRawArray(ramp.b0[band]);
+                db1[k] = DoublePair::fromRawArray(ramp.b1[band]);
+                db2[k] = DoublePair::fromRawArray(ramp.b2[band]);
+                da1[k] = DoublePair::fromRawArray(ramp.a1[band]);
+                da2[k] = DoublePair::fromRawArray(ramp.a2[band]);
+            }
+        }
+
+        alignas(16) double frame[NumLanes];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (glide)
+            {
+                for (int k = 0; k < numActive; ++k)
+                {
+                    b0[k] = b0[k] + db0[k];
+                    b1[k] = b1[k] + db1[k];
+                    b2[k] = b2[k] + db2[k];
+                    a1[k] = a1[k] + da1[k];
+                    a2[k] = a2[k] + da2[k];
+                }
+            }
+
+            frame[0] = static_cast<double>(left[i]);
+            frame[1] = static_cast<double>(right[i]);
+            auto x = DoublePair::fromRawArray(frame);
+
+            // Bands in series, kept in 64-bit between sections
+            for (int k = 0; k < numActive; ++k)
+            {
+                const int in = inputIndex[k];
+                const int out = activeBands[k] + 1;
+
+                auto y = b0[k] * x + b1[k] * z1[in] + b2[k] * z2[in]
+                       - a1[k] * z1[out] - a2[k] * z2[out];
+
+                z2[in] = z1[in];
+                z1[in] = x;
+                x = y;
+            }
+
+            z2[lastBoundary] = z1[lastBoundary];
+            z1[lastBoundary] = x;
+
+            x.copyToRawArray(frame);
+            left[i] = static_cast<SampleType>(frame[0]);
+            right[i] = static_cast<SampleType>(frame[1]);
+        }
+
+        // Forward history across skipped sections so they can rejoin without a step
+        for (int i = 1; i <= NumBands; ++i)
+        {
+            if (bypassed[i - 1][0] && bypassed[i - 1][1])
+            {
+                z1[i] = z1[i - 1];
+                z2[i] = z2[i - 1];
+            }
+        }
+
+        for (int i = 0; i <= NumBands; ++i)
+        {
+            z1[i].copyToRawArray(state.z1[i]);
+            z2[i].copyToRawArray(state.z2[i]);
+        }
+
+        // Land exactly on the designed coefficients rather than the accumulated sum
+        if (glide)
+        {
+            for (int band = 0; band < NumBands; ++band)
+            {
+                for (int lane = 0; lane < NumLanes; ++lane)
+                {
+                    const auto target = ramp.target[band][lane];
+                    coeffs.b0[band][lane] = target.b0;
+                    coeffs.b1[band][lane] = target.b1;
+                    coeffs.b2[band][lane] = target.b2;
+                    coeffs.a1[band][lane] = target.a1;
+                    coeffs.a2[band][lane] = target.a2;
+                    clearRamp(band, lane, target);
+                }
+            }
+
+            ramping = false;
+        }
+    }
+
+    template void StereoBiquadKernel::processBlock<float>(float*, float*, int);
+    template void StereoBiquadKernel::processBlock<double>(double*, double*, int);
+}
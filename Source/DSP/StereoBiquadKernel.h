@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    StereoBiquadKernel - Block-Based Stereo Biquad Cascade (64-bit, SIMD)
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <juce_core/juce_core.h>
+#include "BiquadCoefficients.h"
+
+namespace Aetheri
+{
+    /**
+     * Four-band biquad cascade for both channels (L/R or M/S) at once
+     * Each channel occupies one lane of a double x2 SIMD register (SSE2/NEON),
+     * coefficients and state are kept in cache-aligned SoA storage
+     */
+    class StereoBiquadKernel
+    {
+    public:
+        static constexpr int NumBands = 4;
+        static constexpr int NumLanes = 2;
+
+        StereoBiquadKernel() = default;
+
+        void reset();
+
+        // Lane 0 = L/M, lane 1 = R/S
+        void setBandCoefficients(int band, int lane, const BiquadCoefficients& coeffs);
+        void setBandBypassed(int band, int lane);
+
+        // Linear per-sample glide to new coefficients over the next processBlock call,
+        // which must cover exactly numSamples
+        void rampBandCoefficients(int band, int lane, const BiquadCoefficients& target, int numSamples);
+
+        // True once a band has settled on (or been bypassed to) unity coefficients and its
+        // output history has caught up with its input, so skipping it is seamless
+        bool isBandUnity(int band, int lane) const;
+
+        // Seeds the cascade history from the last two input frames ([lane] each), e.g. when
+        // the EQ rejoins the chain after being skipped as neutral
+        void setHistory(const double* previousFrame, const double* lastFrame);
+
+        // Each band's state, for handing the filter over to another engine mid-stream
+        void getSectionStates(SectionState (&states)[NumBands][NumLanes]) const;
+        // Rebuilds the cascade history from band states, continuing after the given input
+        // frames ([lane] each); the band coefficients have to be set first
+        void setSectionStates(const SectionState (&states)[NumBands][NumLanes],
+                              const double* previousFrame, const double* lastFrame);
+
+        template <typename SampleType>
+        void processBlock(SampleType* left, SampleType* right, int numSamples);
+
+    private:
+        // Coefficients [band][lane]
+        struct alignas(64) Coefficients
+        {
+            alignas(16) double b0[NumBands][NumLanes];
+            alignas(16) double b1[NumBands][NumLanes];
+            alignas(16) double b2[NumBands][NumLanes];
+            alignas(16) double a1[NumBands][NumLanes];
+            alignas(16) double a2[NumBands][NumLanes];
+        };
+
+        // Direct Form I with the history shared along the cascade:
+        // history[0] holds the input, history[i + 1] the output of band i
+        struct alignas(64) State
+        {
+            alignas(16) double z1[NumBands + 1][NumLanes];
+            alignas(16) double z2[NumBands + 1][NumLanes];
+        };
+
+        // Per-sample coefficient increments and end points of a pending ramp
+        struct alignas(64) Ramp
+        {
+            alignas(16) double b0[NumBands][NumLanes];
+            alignas(16) double b1[NumBands][NumLanes];
+            alignas(16) double b2[NumBands][NumLanes];
+            alignas(16) double a1[NumBands][NumLanes];
+            alignas(16) double a2[NumBands][NumLanes];
+            BiquadCoefficients target[NumBands][NumLanes];
+        };
+
+        Coefficients coeffs = makeUnityCoefficients();
+        State state {};
+        Ramp ramp {};
+        bool ramping = false;
+        bool bypassed[NumBands][NumLanes] = { { true, true }, { true, true }, { true, true }, { true, true } };
+
+        static Coefficients makeUnityCoefficients();
+        void clearRamp(int band, int lane, const BiquadCoefficients& c);
+    };
+}
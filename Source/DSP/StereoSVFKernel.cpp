@@ -0,0 +1,410 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    StereoSVFKernel Implementation
+  ==============================================================================
+*/
+
+#include "StereoSVFKernel.h"
+
+#if JUCE_USE_SIMD && JUCE_INTEL
+ #include <xmmintrin.h>
+#elif JUCE_USE_SIMD && JUCE_ARM
+ #include <arm_neon.h>
+#endif
+
+namespace Aetheri
+{
+    namespace
+    {
+        // Four floats; SIMDRegister has no lane shuffles, which the pipeline needs every sample
+       #if JUCE_USE_SIMD && JUCE_INTEL
+        struct FloatQuad
+        {
+            __m128 v;
+
+            static FloatQuad load(const float* a) noexcept           { return { _mm_load_ps(a) }; }
+            void store(float* a) const noexcept                      { _mm_store_ps(a, v); }
+            static FloatQuad pair(float l, float r) noexcept         { return { _mm_setr_ps(l, r, 0.0f, 0.0f) }; }
+
+            // [a0 a1 b0 b1] and [a2 a3 b0 b1]
+            static FloatQuad joinLow(FloatQuad a, FloatQuad b) noexcept     { return { _mm_movelh_ps(a.v, b.v) }; }
+            static FloatQuad joinHighLow(FloatQuad a, FloatQuad b) noexcept { return { _mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(1, 0, 3, 2)) }; }
+
+            FloatQuad operator+(FloatQuad o) const noexcept { return { _mm_add_ps(v, o.v) }; }
+            FloatQuad operator-(FloatQuad o) const noexcept { return { _mm_sub_ps(v, o.v) }; }
+            FloatQuad operator*(FloatQuad o) const noexcept { return { _mm_mul_ps(v, o.v) }; }
+        };
+       #elif JUCE_USE_SIMD && JUCE_ARM
+        struct FloatQuad
+        {
+            float32x4_t v;
+
+            static FloatQuad load(const float* a) noexcept           { return { vld1q_f32(a) }; }
+            void store(float* a) const noexcept                      { vst1q_f32(a, v); }
+            static FloatQuad pair(float l, float r) noexcept         { const float a[4] = { l, r, 0.0f, 0.0f }; return { vld1q_f32(a) }; }
+
+            static FloatQuad joinLow(FloatQuad a, FloatQuad b) noexcept     { return { vcombine_f32(vget_low_f32(a.v), vget_low_f32(b.v)) }; }
+            static FloatQuad joinHighLow(FloatQuad a, FloatQuad b) noexcept { return { vcombine_f32(vget_high_f32(a.v), vget_low_f32(b.v)) }; }
+
+            FloatQuad operator+(FloatQuad o) const noexcept { return { vaddq_f32(v, o.v) }; }
+            FloatQuad operator-(FloatQuad o) const noexcept { return { vsubq_f32(v, o.v) }; }
+            FloatQuad operator*(FloatQuad o) const noexcept { return { vmulq_f32(v, o.v) }; }
+        };
+       #else
+        // Scalar stand-in with the same interface
+        struct FloatQuad
+        {
+            float v[4];
+
+            static FloatQuad load(const float* a) noexcept           { return { { a[0], a[1], a[2], a[3] } }; }
+            void store(float* a) const noexcept                      { for (int i = 0; i < 4; ++i) a[i] = v[i]; }
+            static FloatQuad pair(float l, float r) noexcept         { return { { l, r, 0.0f, 0.0f } }; }
+
+            static FloatQuad joinLow(FloatQuad a, FloatQuad b) noexcept     { return { { a.v[0], a.v[1], b.v[0], b.v[1] } }; }
+            static FloatQuad joinHighLow(FloatQuad a, FloatQuad b) noexcept { return { { a.v[2], a.v[3], b.v[0], b.v[1] } }; }
+
+            FloatQuad operator+(FloatQuad o) const noexcept { return { { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] } }; }
+            FloatQuad operator-(FloatQuad o) const noexcept { return { { v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3] } }; }
+            FloatQuad operator*(FloatQuad o) const noexcept { return { { v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3] } }; }
+        };
+       #endif
+
+        // Rows of the pipeline's working set, one float per slot and lane
+        enum Row { K1, K2, K3, M0, M1, M2, DK1, DK2, DK3, DM0, DM1, DM2, S1, S2, NumRows };
+    }
+
+    void StereoSVFKernel::reset()
+    {
+        for (int band = 0; band < NumBands; ++band)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane)
+            {
+                state[band][lane] = {};
+                lastInput[band][lane] = 0.0f;
+            }
+        }
+    }
+
+    void StereoSVFKernel::setBandCoefficients(int band, int lane, const BiquadCoefficients& c)
+    {
+        jassert(band >= 0 && band < NumBands && lane >= 0 && lane < NumLanes);
+
+        if (bypassed[band][lane])
+            state[band][lane].setHistory(lastInput[band][lane]);
+
+        coeffs[band][lane] = targets[band][lane] = SVFCoefficients::fromBiquad(c);
+        deltas[band][lane] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        bypassed[band][lane] = false;
+    }
+
+    void StereoSVFKernel::setBandBypassed(int band, int lane)
+    {
+        // Unity section - the signal passes through
+        setBandCoefficients(band, lane, BiquadCoefficients {});
+        bypassed[band][lane] = true;
+    }
+
+    void StereoSVFKernel::rampBandCoefficients(int band, int lane, const BiquadCoefficients& target, int numSamples)
+    {
+        jassert(band >= 0 && band < NumBands && lane >= 0 && lane < NumLanes);
+
+        if (numSamples <= 1)
+        {
+            setBandCoefficients(band, lane, target);
+            return;
+        }
+
+        auto design = SVFCoefficients::fromBiquad(target);
+        auto& current = coeffs[band][lane];
+
+        // Fading out only needs the mix - the integrators keep their tuning
+        if (target.isUnity())
+        {
+            design.k1 = targets[band][lane].k1;
+            design.k2 = targets[band][lane].k2;
+            design.k3 = targets[band][lane].k3;
+        }
+
+        // A bypassed band glides in from a unity mix on the new integrators, which
+        // start from the settled state for its recent input
+        if (bypassed[band][lane])
+        {
+            current = design;
+            current.m0 = 1.0f;
+            current.m1 = current.m2 = 0.0f;
+            state[band][lane].setHistory(lastInput[band][lane]);
+            bypassed[band][lane] = false;
+        }
+
+        const float scale = 1.0f / static_cast<float>(numSamples);
+        auto& delta = deltas[band][lane];
+        delta = { (design.k1 - current.k1) * scale, (design.k2 - current.k2) * scale,
+                  (design.k3 - current.k3) * scale, (design.m0 - current.m0) * scale,
+                  (design.m1 - current.m1) * scale, (design.m2 - current.m2) * scale };
+        targets[band][lane] = design;
+
+        ramping = ramping || delta.k1 != 0.0f || delta.k2 != 0.0f || delta.k3 != 0.0f
+                          || delta.m0 != 0.0f || delta.m1 != 0.0f || delta.m2 != 0.0f;
+    }
+
+    bool StereoSVFKernel::isBandUnity(int band, int lane) const
+    {
+        return coeffs[band][lane].isUnity() && targets[band][lane].isUnity();
+    }
+
+    void StereoSVFKernel::setHistory(const double* /*previousFrame*/, const double* lastFrame)
+    {
+        for (int band = 0; band < NumBands; ++band)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane)
+            {
+                lastInput[band][lane] = static_cast<float>(lastFrame[lane]);
+                state[band][lane].setHistory(lastInput[band][lane]);
+            }
+        }
+    }
+
+    void StereoSVFKernel::getSectionStates(SectionState (&states)[NumBands][NumLanes]) const
+    {
+        for (int band = 0; band < NumBands; ++band)
+            for (int lane = 0; lane < NumLanes; ++lane)
+                states[band][lane] = bypassed[band][lane] ? SectionState {} : state[band][lane].toSectionState(coeffs[band][lane]);
+    }
+
+    void StereoSVFKernel::setSectionStates(const SectionState (&states)[NumBands][NumLanes], const double* lastFrame)
+    {
+        for (int band = 0; band < NumBands; ++band)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane)
+            {
+                lastInput[band][lane] = static_cast<float>(lastFrame[lane]);
+                state[band][lane] = SVFState::fromSectionState(states[band][lane], coeffs[band][lane], lastInput[band][lane]);
+            }
+        }
+    }
+
+    template <typename SampleType>
+    void StereoSVFKernel::processBlock(SampleType* left, SampleType* right, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+
+        // Skipped sections leave the signal untouched; only live ones run
+        int activeBands[NumBands];
+        int numActive = 0;
+
+        for (int band = 0; band < NumBands; ++band)
+            if (!(bypassed[band][0] && bypassed[band][1]))
+                activeBands[numActive++] = band;
+
+        // Two sections per register; an odd section count runs a unity section in the spare slot
+        if (numActive == 0)
+        {
+            for (int band = 0; band < NumBands; ++band)
+            {
+                lastInput[band][0] = static_cast<float>(left[numSamples - 1]);
+                lastInput[band][1] = static_cast<float>(right[numSamples - 1]);
+            }
+        }
+        else if (numActive <= 2)
+        {
+            processPipelined<1>(left, right, numSamples, activeBands, numActive);
+        }
+        else
+        {
+            processPipelined<2>(left, right, numSamples, activeBands, numActive);
+        }
+
+        // Land exactly on the designed mix rather than the accumulated sum
+        if (ramping)
+        {
+            for (int band = 0; band < NumBands; ++band)
+            {
+                for (int lane = 0; lane < NumLanes; ++lane)
+                {
+                    coeffs[band][lane] = targets[band][lane];
+                    deltas[band][lane] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+                }
+            }
+
+            ramping = false;
+        }
+    }
+
+    template <int NumRegisters, typename SampleType>
+    void StereoSVFKernel::processPipelined(SampleType* left, SampleType* right, int numSamples,
+                                           const int* activeBands, int numActive)
+    {
+        // Section k runs sample t - k at step t, so every section in a step is independent
+        // and a register holds two sections of both lanes: [k L, k R, k+1 L, k+1 R]
+        constexpr int NumSlots = 2 * NumRegisters;
+        constexpr int Width = NumSlots * NumLanes;
+        constexpr int FirstFullStep = NumSlots - 1;
+
+        alignas(16) float rows[NumRows][Width];
+        alignas(16) float taps[Width];   // Input to each slot at its latest sample
+        alignas(16) float outputs[Width]; // Output of each slot at its latest sample
+
+        for (int slot = 0; slot < NumSlots; ++slot)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane)
+            {
+                const bool live = slot < numActive;
+                const int band = live ? activeBands[slot] : 0;
+                const auto c = live ? coeffs[band][lane] : SVFCoefficients {};
+                const auto d = live ? deltas[band][lane] : SVFCoefficients { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+                const auto st = live ? state[band][lane] : SVFState {};
+                const int e = slot * NumLanes + lane;
+
+                rows[K1][e] = c.k1;  rows[K2][e] = c.k2;  rows[K3][e] = c.k3;
+                rows[M0][e] = c.m0;  rows[M1][e] = c.m1;  rows[M2][e] = c.m2;
+                rows[DK1][e] = d.k1; rows[DK2][e] = d.k2; rows[DK3][e] = d.k3;
+                rows[DM0][e] = d.m0; rows[DM1][e] = d.m1; rows[DM2][e] = d.m2;
+                rows[S1][e] = st.s1; rows[S2][e] = st.s2;
+                taps[e] = outputs[e] = 0.0f;
+            }
+        }
+
+        SampleType* channels[NumLanes] = { left, right };
+        const bool glide = ramping;
+
+        // Filling and draining the pipeline: only the slots that have a sample at this step
+        auto partialStep = [&] (int t)
+        {
+            // Last slot first, so each slot still reads the previous step's output before it
+            for (int slot = NumSlots - 1; slot >= 0; --slot)
+            {
+                const int i = t - slot;
+
+                if (i < 0 || i >= numSamples)
+                    continue;
+
+                for (int lane = 0; lane < NumLanes; ++lane)
+                {
+                    const int e = slot * NumLanes + lane;
+                    const float x = slot == 0 ? static_cast<float>(channels[lane][i]) : outputs[e - NumLanes];
+
+                    if (glide)
+                    {
+                        rows[K1][e] += rows[DK1][e]; rows[K2][e] += rows[DK2][e]; rows[K3][e] += rows[DK3][e];
+                        rows[M0][e] += rows[DM0][e]; rows[M1][e] += rows[DM1][e]; rows[M2][e] += rows[DM2][e];
+                    }
+
+                    float& s1 = rows[S1][e];
+                    float& s2 = rows[S2][e];
+                    const float y = rows[M0][e] * x + rows[M1][e] * s1 + rows[M2][e] * s2;
+                    const float v = x - s2;
+                    s2 += rows[K2][e] * s1 + rows[K3][e] * v;
+                    s1 = rows[K1][e] * s1 + rows[K2][e] * v;
+
+                    taps[e] = x;
+                    outputs[e] = y;
+
+                    if (slot == NumSlots - 1)
+                        channels[lane][i] = static_cast<SampleType>(y);
+                }
+            }
+        };
+
+        for (int t = 0; t < FirstFullStep; ++t)
+            partialStep(t);
+
+        // Every slot busy: whole registers per step
+        if (numSamples > FirstFullStep)
+        {
+            FloatQuad k1[NumRegisters], k2[NumRegisters], k3[NumRegisters];
+            FloatQuad m0[NumRegisters], m1[NumRegisters], m2[NumRegisters];
+            FloatQuad s1[NumRegisters], s2[NumRegisters], x[NumRegisters], y[NumRegisters];
+
+            for (int r = 0; r < NumRegisters; ++r)
+            {
+                k1[r] = FloatQuad::load(rows[K1] + 4 * r); k2[r] = FloatQuad::load(rows[K2] + 4 * r);
+                k3[r] = FloatQuad::load(rows[K3] + 4 * r); m0[r] = FloatQuad::load(rows[M0] + 4 * r);
+                m1[r] = FloatQuad::load(rows[M1] + 4 * r); m2[r] = FloatQuad::load(rows[M2] + 4 * r);
+                s1[r] = FloatQuad::load(rows[S1] + 4 * r); s2[r] = FloatQuad::load(rows[S2] + 4 * r);
+                y[r] = FloatQuad::load(outputs + 4 * r);
+            }
+
+            auto runSteps = [&] (auto gliding)
+            {
+                FloatQuad dk1[NumRegisters], dk2[NumRegisters], dk3[NumRegisters];
+                FloatQuad dm0[NumRegisters], dm1[NumRegisters], dm2[NumRegisters];
+
+                if constexpr (decltype(gliding)::value)
+                {
+                    for (int r = 0; r < NumRegisters; ++r)
+                    {
+                        dk1[r] = FloatQuad::load(rows[DK1] + 4 * r); dk2[r] = FloatQuad::load(rows[DK2] + 4 * r);
+                        dk3[r] = FloatQuad::load(rows[DK3] + 4 * r); dm0[r] = FloatQuad::load(rows[DM0] + 4 * r);
+                        dm1[r] = FloatQuad::load(rows[DM1] + 4 * r); dm2[r] = FloatQuad::load(rows[DM2] + 4 * r);
+                    }
+                }
+
+                alignas(16) float last[4];
+
+                for (int t = FirstFullStep; t < numSamples; ++t)
+                {
+                    // Each slot takes the previous slot's output from the last step
+                    x[0] = FloatQuad::joinLow(FloatQuad::pair(static_cast<float>(left[t]), static_cast<float>(right[t])), y[0]);
+
+                    if constexpr (NumRegisters == 2)
+                        x[1] = FloatQuad::joinHighLow(y[0], y[1]);
+
+                    for (int r = 0; r < NumRegisters; ++r)
+                    {
+                        if constexpr (decltype(gliding)::value)
+                        {
+                            k1[r] = k1[r] + dk1[r]; k2[r] = k2[r] + dk2[r]; k3[r] = k3[r] + dk3[r];
+                            m0[r] = m0[r] + dm0[r]; m1[r] = m1[r] + dm1[r]; m2[r] = m2[r] + dm2[r];
+                        }
+
+                        y[r] = m1[r] * s1[r] + m2[r] * s2[r] + m0[r] * x[r];
+                        const auto v = x[r] - s2[r];
+                        s2[r] = s2[r] + (k2[r] * s1[r] + k3[r] * v);
+                        s1[r] = k1[r] * s1[r] + k2[r] * v;
+                    }
+
+                    y[NumRegisters - 1].store(last);
+                    left[t - FirstFullStep] = static_cast<SampleType>(last[2]);
+                    right[t - FirstFullStep] = static_cast<SampleType>(last[3]);
+                }
+            };
+
+            if (glide)
+                runSteps(std::true_type {});
+            else
+                runSteps(std::false_type {});
+
+            for (int r = 0; r < NumRegisters; ++r)
+            {
+                k1[r].store(rows[K1] + 4 * r); k2[r].store(rows[K2] + 4 * r); k3[r].store(rows[K3] + 4 * r);
+                m0[r].store(rows[M0] + 4 * r); m1[r].store(rows[M1] + 4 * r); m2[r].store(rows[M2] + 4 * r);
+                s1[r].store(rows[S1] + 4 * r); s2[r].store(rows[S2] + 4 * r);
+                x[r].store(taps + 4 * r);
+                y[r].store(outputs + 4 * r);
+            }
+        }
+
+        for (int t = std::max(FirstFullStep, numSamples); t < numSamples + FirstFullStep; ++t)
+            partialStep(t);
+
+        for (int k = 0; k < numActive; ++k)
+            for (int lane = 0; lane < NumLanes; ++lane)
+                state[activeBands[k]][lane] = { rows[S1][k * NumLanes + lane], rows[S2][k * NumLanes + lane] };
+
+        // A skipped band sees the output of the live band before it
+        for (int band = 0, k = 0; band < NumBands; ++band)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane)
+                lastInput[band][lane] = k < NumSlots ? taps[k * NumLanes + lane]
+                                                     : outputs[(NumSlots - 1) * NumLanes + lane];
+
+            if (k < numActive && activeBands[k] == band)
+                ++k;
+        }
+    }
+
+    template void StereoSVFKernel::processBlock<float>(float*, float*, int);
+    template void StereoSVFKernel::processBlock<double>(double*, double*, int);
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    StereoSVFKernel - Block-Based Stereo State-Variable Cascade (32-bit eco)
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_core/juce_core.h>
+#include "BiquadCoefficients.h"
+
+namespace Aetheri
+{
+    /**
+     * Four-band cascade for both channels (L/R or M/S) in 32-bit float state
+     * Each band runs as a trapezoidal state-variable section converted from its biquad
+     * design, so low shelves stay within -95 dB of the 64-bit kernels at 192 kHz.
+     * The cascade is skewed by one sample per section, which makes the sections of a
+     * step independent: two sections of both lanes share one 4-float SIMD register.
+     * Same control interface as StereoBiquadKernel, so PassiveEQ drives either one
+     */
+    class StereoSVFKernel
+    {
+    public:
+        static constexpr int NumBands = 4;
+        static constexpr int NumLanes = 2;
+
+        StereoSVFKernel() = default;
+
+        void reset();
+
+        // Lane 0 = L/M, lane 1 = R/S
+        void setBandCoefficients(int band, int lane, const BiquadCoefficients& coeffs);
+        void setBandBypassed(int band, int lane);
+
+        // Linear per-sample glide of the SVF gains and mix over the next processBlock call,
+        // which must cover exactly numSamples
+        void rampBandCoefficients(int band, int lane, const BiquadCoefficients& target, int numSamples);
+
+        // A unity mix passes the input straight through whatever the section state,
+        // so a band can be skipped as soon as it has settled there
+        bool isBandUnity(int band, int lane) const;
+
+        // Seeds every section from the last input frame ([lane]), e.g. when the EQ
+        // rejoins the chain after being skipped as neutral
+        void setHistory(const double* previousFrame, const double* lastFrame);
+
+        // Each band's state, for handing the filter over to another engine mid-stream
+        void getSectionStates(SectionState (&states)[NumBands][NumLanes]) const;
+        // Takes band states over from another engine after the given last input frame
+        // ([lane]); the band coefficients have to be set first
+        void setSectionStates(const SectionState (&states)[NumBands][NumLanes], const double* lastFrame);
+
+        template <typename SampleType>
+        void processBlock(SampleType* left, SampleType* right, int numSamples);
+
+    private:
+        SVFCoefficients coeffs[NumBands][NumLanes];
+        SVFCoefficients deltas[NumBands][NumLanes];
+        SVFCoefficients targets[NumBands][NumLanes];
+        SVFState state[NumBands][NumLanes];
+
+        // Last input seen by each band, to seed a bypassed section when it comes back
+        float lastInput[NumBands][NumLanes] {};
+
+        bool ramping = false;
+        bool bypassed[NumBands][NumLanes] = { { true, true }, { true, true }, { true, true }, { true, true } };
+
+        template <int NumRegisters, typename SampleType>
+        void processPipelined(SampleType* left, SampleType* right, int numSamples, const int* activeBands, int numActive);
+    };
+}
@@ -46,38 +46,38 @@ namespace Aetheri
         lufsLevel = 0.0f;
     }
     
-    void VUMeter::pushSamples(const float* data, int numSamples)
+    template <typename SampleType>
+    void VUMeter::pushSamples(const SampleType* data, int numSamples)
     {
+        double sumOfSquares = 0.0;
+        SampleType blockPeak = 0;
+        
         for (int i = 0; i < numSamples; ++i)
         {
-            float sample = data[i];
-            float absSample = std::abs(sample);
-            
-            // Always accumulate for RMS/LUFS (needed for multiple modes)
-            rmsSum += static_cast<double>(sample * sample);
-            rmsSampleCount++;
-            
-            // LUFS accumulation (same as RMS for now, K-weighting would be added here)
-            lufsSum += static_cast<double>(sample * sample);
-            lufsSampleCount++;
-            
-            // Peak detection (always active for peak indicator)
-            if (absSample > peakLevel)
-            {
-                peakLevel = absSample;
-                currentPeakHold = 0;
-            }
-            else
-            {
-                currentPeakHold++;
-                if (currentPeakHold > peakHoldSamples)
-                {
-                    // Decay peak after hold time
-                    peakLevel *= peakDecayCoeff;
-                }
-            }
+            sumOfSquares += static_cast<double>(data[i] * data[i]);
+            blockPeak = std::max(blockPeak, std::abs(data[i]));
         }
         
+        addBlock(data, sumOfSquares, static_cast<float>(blockPeak), numSamples);
+    }
+    
+    template <typename SampleType>
+    void VUMeter::addBlock(const SampleType* data, double sumOfSquares, float blockPeak, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+        
+        // Always accumulate for RMS/LUFS (needed for multiple modes)
+        rmsSum += sumOfSquares;
+        rmsSampleCount += numSamples;
+        
+        // LUFS accumulation (same as RMS for now, K-weighting would be added here)
+        lufsSum += sumOfSquares;
+        lufsSampleCount += numSamples;
+        
+        // Peak detection (always active for peak indicator)
+        updatePeakHold(data, blockPeak, numSamples);
+        
         // Update based on current mode (after accumulating samples)
         switch (meterMode)
         {
@@ -96,6 +96,41 @@ namespace Aetheri
         }
     }
     
+    template <typename SampleType>
+    void VUMeter::updatePeakHold(const SampleType* data, float blockPeak, int numSamples)
+    {
+        // Samples past the hold time decay the peak once each
+        const int decaySamples = juce::jlimit(0, numSamples, currentPeakHold + numSamples - peakHoldSamples);
+        const float lowestPeak = decaySamples > 0 ? peakLevel * std::pow(peakDecayCoeff, static_cast<float>(decaySamples))
+                                                  : peakLevel;
+        
+        // Nothing in the block reaches the held peak at any point: hold and decay in one step
+        if (blockPeak <= lowestPeak)
+        {
+            // Past the hold time only the fact counts, so the count stops there
+            peakLevel = lowestPeak;
+            currentPeakHold = std::min(currentPeakHold + numSamples, peakHoldSamples + 1);
+            return;
+        }
+        
+        // A new peak lands somewhere in the block, which restarts the hold from that sample
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float absSample = static_cast<float>(std::abs(data[i]));
+            
+            if (absSample > peakLevel)
+            {
+                peakLevel = absSample;
+                currentPeakHold = 0;
+            }
+            else if (++currentPeakHold > peakHoldSamples)
+            {
+                // Decay peak after hold time
+                peakLevel *= peakDecayCoeff;
+            }
+        }
+    }
+    
     void VUMeter::updateRMS()
     {
         // Calculate RMS when window is full, or update more frequently for responsiveness
@@ -319,19 +354,95 @@ namespace Aetheri
         {
             meter.reset();
         }
+        
+        phaseCorrelation = 0.0f;
+        correlationSums = {};
+    }
+    
+    template <typename SampleType>
+    void StereoVUMeter::pushSamples(const juce::dsp::AudioBlock<SampleType>& block)
+    {
+        int numSamples = static_cast<int>(block.getNumSamples());
+        
+        if (block.getNumChannels() < 2)
+        {
+            if (block.getNumChannels() == 1)
+                meters[0].pushSamples(block.getChannelPointer(0), numSamples);
+            
+            phaseCorrelation = 0.0f;
+            correlationSums = {};
+            channelsIdentical = false;
+            return;
+        }
+        
+        // One pass over both channels feeds both meters (and the correlation sums)
+        if (correlationEnabled)
+            scanStereo<true>(block.getChannelPointer(0), block.getChannelPointer(1), numSamples);
+        else
+            scanStereo<false>(block.getChannelPointer(0), block.getChannelPointer(1), numSamples);
     }
     
-    void StereoVUMeter::pushSamples(const juce::AudioBuffer<float>& buffer)
+    template <bool MeasureCorrelation, typename SampleType>
+    void StereoVUMeter::scanStereo(const SampleType* left, const SampleType* right, int numSamples)
     {
-        int numChannels = std::min(buffer.getNumChannels(), 2);
-        int numSamples = buffer.getNumSamples();
+        double sumL2 = 0.0, sumR2 = 0.0, sumL = 0.0, sumR = 0.0, sumLR = 0.0;
+        SampleType peakL = 0, peakR = 0;
+        int differences = 0;  // Branch-free, so the compare vectorises with the rest
         
-        for (int ch = 0; ch < numChannels; ++ch)
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double l = static_cast<double>(left[i]);
+            const double r = static_cast<double>(right[i]);
+            
+            sumL2 += l * l;
+            sumR2 += r * r;
+            peakL = std::max(peakL, std::abs(left[i]));
+            peakR = std::max(peakR, std::abs(right[i]));
+            differences |= static_cast<int>(left[i] != right[i]);
+            
+            if constexpr (MeasureCorrelation)
+            {
+                sumL += l;
+                sumR += r;
+                sumLR += l * r;
+            }
+        }
+        
+        meters[0].addBlock(left, sumL2, static_cast<float>(peakL), numSamples);
+        meters[1].addBlock(right, sumR2, static_cast<float>(peakR), numSamples);
+        channelsIdentical = differences == 0;
+        
+        if constexpr (MeasureCorrelation)
         {
-            meters[ch].pushSamples(buffer.getReadPointer(ch), numSamples);
+            correlationSums.left += sumL;
+            correlationSums.right += sumR;
+            correlationSums.product += sumLR;
+            correlationSums.leftSquares += sumL2;
+            correlationSums.rightSquares += sumR2;
+            correlationSums.numSamples += numSamples;
         }
     }
     
+    void StereoVUMeter::updatePhaseCorrelation()
+    {
+        const auto sums = correlationSums;
+        correlationSums = {};
+        
+        if (sums.numSamples <= 0)
+            return;
+        
+        // Calculate correlation coefficient
+        const double n = static_cast<double>(sums.numSamples);
+        double meanL = sums.left / n;
+        double meanR = sums.right / n;
+        double covLR = (sums.product / n) - (meanL * meanR);
+        double varL = (sums.leftSquares / n) - (meanL * meanL);
+        double varR = (sums.rightSquares / n) - (meanR * meanR);
+        
+        double denom = std::sqrt(std::max(0.0, varL * varR));
+        phaseCorrelation = denom > 0.0001 ? static_cast<float>(covLR / denom) : 0.0f;
+    }
+    
     void StereoVUMeter::setMode(MeterMode mode)
     {
         for (auto& meter : meters)
@@ -339,4 +450,9 @@ namespace Aetheri
             meter.setMode(mode);
         }
     }
+    
+    template void VUMeter::pushSamples<float>(const float*, int);
+    template void VUMeter::pushSamples<double>(const double*, int);
+    template void StereoVUMeter::pushSamples<float>(const juce::dsp::AudioBlock<float>&);
+    template void StereoVUMeter::pushSamples<double>(const juce::dsp::AudioBlock<double>&);
 }
@@ -34,7 +34,13 @@ namespace Aetheri
         void prepare(double sampleRate);
         void reset();
         
-        void pushSamples(const float* data, int numSamples);
+        template <typename SampleType>
+        void pushSamples(const SampleType* data, int numSamples);
+        
+        // Feed a block already reduced to its sum of squares and absolute peak; the samples
+        // are only revisited when the peak hold has to be followed sample by sample
+        template <typename SampleType>
+        void addBlock(const SampleType* data, double sumOfSquares, float blockPeak, int numSamples);
         
         // Set meter mode
         void setMode(MeterMode mode) { meterMode = mode; reset(); }
@@ -80,6 +86,10 @@ namespace Aetheri
         // Current level (mode-dependent)
         float currentLevel = 0.0f;
         
+        // Per-sample peak hold and decay, whatever the block size
+        template <typename SampleType>
+        void updatePeakHold(const SampleType* data, float blockPeak, int numSamples);
+        
         // Mode-specific calculations
         void updateRMS();
         void updatePeak();
@@ -101,11 +111,23 @@ namespace Aetheri
         void prepare(double sampleRate);
         void reset();
         
-        void pushSamples(const juce::AudioBuffer<float>& buffer);
+        template <typename SampleType>
+        void pushSamples(const juce::dsp::AudioBlock<SampleType>& block);
         
         void setMode(MeterMode mode);
         MeterMode getMode() const { return meters[0].getMode(); }
         
+        // Phase correlation of the pushed blocks, gathered in the same pass as the levels.
+        // The sums run across pushes until updatePhaseCorrelation() turns them into a reading,
+        // so a host block pushed in sub-blocks is measured as a whole
+        void setCorrelationEnabled(bool shouldMeasure) { correlationEnabled = shouldMeasure; }
+        void updatePhaseCorrelation();
+        float getPhaseCorrelation() const { return phaseCorrelation; }
+        
+        // True when both channels of the last pushed block matched sample for sample,
+        // compared in the same pass
+        bool wereChannelsIdentical() const { return channelsIdentical; }
+        
         VUMeter& getLeft() { return meters[0]; }
         VUMeter& getRight() { return meters[1]; }
         
@@ -114,5 +136,19 @@ namespace Aetheri
         
     private:
         std::array<VUMeter, 2> meters;
+        bool correlationEnabled = false;
+        float phaseCorrelation = 0.0f;
+        
+        struct CorrelationSums
+        {
+            double left = 0.0, right = 0.0, product = 0.0, leftSquares = 0.0, rightSquares = 0.0;
+            int numSamples = 0;
+        };
+        
+        CorrelationSums correlationSums;
+        bool channelsIdentical = false;
+        
+        template <bool MeasureCorrelation, typename SampleType>
+        void scanStereo(const SampleType* left, const SampleType* right, int numSamples);
     };
 }
@@ -128,6 +128,9 @@ AetheriAudioProcessorEditor::AetheriAudioProcessorEditor(AetheriAudioProcessor&
     rightChannelStrip.toFront(false);
     hysteresisPanel.toFront(false);
     
+    // The nebula visualizer consumes band energy only while an editor is open
+    audioProcessor.setBandEnergyAnalysisEnabled(true);
+    
     // Start timer for UI updates
     startTimerHz(30);  // 30 Hz is sufficient
     
@@ -138,6 +141,7 @@ AetheriAudioProcessorEditor::AetheriAudioProcessorEditor(AetheriAudioProcessor&
 AetheriAudioProcessorEditor::~AetheriAudioProcessorEditor()
 {
     audioProcessor.getParameters().state.removeListener(this);
+    audioProcessor.setBandEnergyAnalysisEnabled(false);
     stopTimer();
     setLookAndFeel(nullptr);
 }
@@ -336,12 +340,40 @@ void AetheriAudioProcessorEditor::setupOversamplingControls()
     oversamplingSelector.addItem("1x", 1);
     oversamplingSelector.addItem("2x", 2);
     oversamplingSelector.addItem("4x", 3);
+    oversamplingSelector.addItem("8x", firstHighOversamplingItem);
+    oversamplingSelector.addItem("16x", firstHighOversamplingItem + 1);
+    oversamplingSelector.addItem("Auto", autoOversamplingItem);
     oversamplingSelector.setSelectedId(1);
     oversamplingSelector.setTooltip("Oversampling: Higher rates reduce aliasing but increase CPU usage");
     addAndMakeVisible(oversamplingSelector);
     
-    oversamplingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
-        audioProcessor.getParameters(), Aetheri::ParamIDs::oversampling, oversamplingSelector);
+    // 1x-4x, 8x/16x and Auto are separate parameters, so the selector drives all three instead
+    // of using an attachment; updateOversamplingDisplay() follows the parameters back
+    oversamplingSelector.onChange = [this] { oversamplingSelected(); };
+    updateOversamplingDisplay();
+    
+    oversamplingFilterSelector.addItem("IIR", 1);
+    oversamplingFilterSelector.addItem("FIR", 2);
+    oversamplingFilterSelector.setSelectedId(1);
+    oversamplingFilterSelector.setTooltip("Oversampling Filter: IIR keeps the latency minimal, FIR is linear phase (adds latency)");
+    addAndMakeVisible(oversamplingFilterSelector);
+    
+    oversamplingFilterAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getParameters(), Aetheri::ParamIDs::oversamplingFilter, oversamplingFilterSelector);
+    
+    linearPhaseButton.setButtonText("LIN PHASE");
+    linearPhaseButton.setTooltip("Linear Phase: Renders the EQ and HPF/LPF as a linear-phase FIR (adds latency)");
+    addAndMakeVisible(linearPhaseButton);
+    
+    linearPhaseAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getParameters(), Aetheri::ParamIDs::linearPhase, linearPhaseButton);
+    
+    ecoPrecisionButton.setButtonText("ECO");
+    ecoPrecisionButton.setTooltip("Eco Precision: Runs the EQ and HPF/LPF as 32-bit state-variable filters");
+    addAndMakeVisible(ecoPrecisionButton);
+    
+    ecoPrecisionAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getParameters(), Aetheri::ParamIDs::ecoPrecision, ecoPrecisionButton);
 }
 
 void AetheriAudioProcessorEditor::setupAutoGainControls()
@@ -564,10 +596,16 @@ void AetheriAudioProcessorEditor::resized()
     phaseCorrMeter.setBounds(stereoArea.removeFromTop(static_cast<int>(40 * scale)).reduced(static_cast<int>(2 * scale)));
     stereoArea.removeFromTop(static_cast<int>(3 * scale));
     
-    // Oversampling, Auto-gain, and Bypass controls
-    oversamplingSelector.setBounds(stereoArea.removeFromTop(static_cast<int>(24 * scale)).reduced(static_cast<int>(2 * scale)));
-    autoGainButton.setBounds(stereoArea.removeFromTop(static_cast<int>(24 * scale)).reduced(static_cast<int>(2 * scale)));
-    bypassButton.setBounds(stereoArea.removeFromTop(static_cast<int>(24 * scale)).reduced(static_cast<int>(2 * scale)));
+    // Oversampling / linear phase, Auto-gain / eco precision, and oversampling filter / Bypass controls
+    auto processingRow = stereoArea.removeFromTop(static_cast<int>(24 * scale));
+    oversamplingSelector.setBounds(processingRow.removeFromLeft(processingRow.getWidth() / 2).reduced(static_cast<int>(2 * scale)));
+    linearPhaseButton.setBounds(processingRow.reduced(static_cast<int>(2 * scale)));
+    auto gainRow = stereoArea.removeFromTop(static_cast<int>(24 * scale));
+    autoGainButton.setBounds(gainRow.removeFromLeft(gainRow.getWidth() / 2).reduced(static_cast<int>(2 * scale)));
+    ecoPrecisionButton.setBounds(gainRow.reduced(static_cast<int>(2 * scale)));
+    auto bypassRow = stereoArea.removeFromTop(static_cast<int>(24 * scale));
+    oversamplingFilterSelector.setBounds(bypassRow.removeFromLeft(bypassRow.getWidth() / 2).reduced(static_cast<int>(2 * scale)));
+    bypassButton.setBounds(bypassRow.reduced(static_cast<int>(2 * scale)));
 
     centerArea.removeFromLeft(static_cast<int>(5 * scale));
     
@@ -592,13 +630,17 @@ void AetheriAudioProcessorEditor::resized()
 
 void AetheriAudioProcessorEditor::timerCallback()
 {
-    updateVUMeters();
+    // One consistent set of readings from the audio thread per frame
+    const auto meters = audioProcessor.getMeterSnapshot();
+    
+    updateVUMeters(meters);
     updateNebulaEnergies();
-    updateTubeGlow();
+    updateTubeGlow(meters);
     updateChannelLabels();
+    updateOversamplingDisplay();
 
     // Update phase correlation meter
-    phaseCorrMeter.updateCorrelation(audioProcessor.getPhaseCorrelation());
+    phaseCorrMeter.updateCorrelation(meters.phaseCorrelation);
 
     // Note: We don't sync the preset selector here anymore.
     // The ComboBox onChange handles setting the program, and the host
@@ -606,46 +648,25 @@ void AetheriAudioProcessorEditor::timerCallback()
     // doesn't need to track in real-time (it would cause race conditions).
 }
 
-void AetheriAudioProcessorEditor::updateVUMeters()
+void AetheriAudioProcessorEditor::updateVUMeters(const Aetheri::MeterSnapshot& meters)
 {
-    // Sync meter modes from UI to DSP only when changed (not every frame)
-    static Aetheri::MeterMode lastInputMode = Aetheri::MeterMode::RMS;
-    static Aetheri::MeterMode lastOutputMode = Aetheri::MeterMode::RMS;
-    
-    auto inputMode = inputVU.getMode();
-    auto outputMode = outputVU.getMode();
-    
-    // Always sync modes to ensure VU and LUFS modes work properly
-    if (inputMode != lastInputMode)
-    {
-        audioProcessor.getInputVU().setMode(inputMode);
-        audioProcessor.getInputVU().reset();  // Reset to ensure clean mode switch
-        lastInputMode = inputMode;
-    }
-    
-    if (outputMode != lastOutputMode)
-    {
-        audioProcessor.getOutputVU().setMode(outputMode);
-        audioProcessor.getOutputVU().reset();  // Reset to ensure clean mode switch
-        lastOutputMode = outputMode;
-    }
+    // The audio thread owns the DSP meters and picks up a mode change at its next block
+    audioProcessor.setMeterModes(inputVU.getMode(), outputVU.getMode());
     
-    // Update input VU meters - use const reference to avoid copying
-    const auto& inVU = audioProcessor.getInputVU();
-    float inLeft = inVU.getLeft().getNormalizedLevel();
-    float inRight = inVU.getRight().getNormalizedLevel();
-    float inLeftPeak = inVU.getLeft().getNormalizedPeak();
-    float inRightPeak = inVU.getRight().getNormalizedPeak();
+    // Update input VU meters
+    float inLeft = meters.inputLevel[0];
+    float inRight = meters.inputLevel[1];
+    float inLeftPeak = meters.inputPeak[0];
+    float inRightPeak = meters.inputPeak[1];
     
     inputVU.setLevels(inLeft, inRight);
     inputVU.setPeakLevels(inLeftPeak, inRightPeak);
     
     // Update output VU meters
-    const auto& outVU = audioProcessor.getOutputVU();
-    float outLeft = outVU.getLeft().getNormalizedLevel();
-    float outRight = outVU.getRight().getNormalizedLevel();
-    float outLeftPeak = outVU.getLeft().getNormalizedPeak();
-    float outRightPeak = outVU.getRight().getNormalizedPeak();
+    float outLeft = meters.outputLevel[0];
+    float outRight = meters.outputLevel[1];
+    float outLeftPeak = meters.outputPeak[0];
+    float outRightPeak = meters.outputPeak[1];
     
     outputVU.setLevels(outLeft, outRight);
     outputVU.setPeakLevels(outLeftPeak, outRightPeak);
@@ -666,9 +687,9 @@ void AetheriAudioProcessorEditor::updateNebulaEnergies()
     }
 }
 
-void AetheriAudioProcessorEditor::updateTubeGlow()
+void AetheriAudioProcessorEditor::updateTubeGlow(const Aetheri::MeterSnapshot& meters)
 {
-    float glowIntensity = audioProcessor.getHysteresisGlowIntensity();
+    float glowIntensity = meters.glowIntensity;
     
     bool hystEnabled = audioProcessor.getParameters().getRawParameterValue(
         Aetheri::ParamIDs::hystEnabled)->load() > 0.5f;
@@ -678,6 +699,73 @@ void AetheriAudioProcessorEditor::updateTubeGlow()
     hysteresisPanel.setGlowIntensity(glowIntensity);
 }
 
+void AetheriAudioProcessorEditor::oversamplingSelected()
+{
+    const int selectedId = oversamplingSelector.getSelectedId();
+    
+    if (selectedId == autoOversamplingItem)
+    {
+        setParameterFromEditor(Aetheri::ParamIDs::oversamplingAuto, 1.0f);
+    }
+    else if (selectedId >= firstHighOversamplingItem)
+    {
+        setParameterFromEditor(Aetheri::ParamIDs::oversamplingAuto, 0.0f);
+        setParameterFromEditor(Aetheri::ParamIDs::highOversampling, static_cast<float>(selectedId - firstHighOversamplingItem + 1));
+    }
+    else if (selectedId > 0)
+    {
+        setParameterFromEditor(Aetheri::ParamIDs::oversamplingAuto, 0.0f);
+        setParameterFromEditor(Aetheri::ParamIDs::highOversampling, 0.0f);
+        setParameterFromEditor(Aetheri::ParamIDs::oversampling, static_cast<float>(selectedId - 1));
+    }
+}
+
+void AetheriAudioProcessorEditor::setParameterFromEditor(const juce::String& parameterID, float plainValue)
+{
+    auto* param = audioProcessor.getParameters().getParameter(parameterID);
+    const float value = param->convertTo0to1(plainValue);
+    
+    if (param->getValue() == value)
+        return;
+    
+    param->beginChangeGesture();
+    param->setValueNotifyingHost(value);
+    param->endChangeGesture();
+}
+
+void AetheriAudioProcessorEditor::updateOversamplingDisplay()
+{
+    // The chosen factor, or in Auto the factor the governor settled on and why
+    const auto& governor = audioProcessor.getOversamplingGovernor();
+    const bool isAuto = audioProcessor.isOversamplingAuto();
+    auto& parameters = audioProcessor.getParameters();
+    const int choice = static_cast<int>(parameters.getRawParameterValue(Aetheri::ParamIDs::oversampling)->load());
+    const int high = static_cast<int>(parameters.getRawParameterValue(Aetheri::ParamIDs::highOversampling)->load());
+    const int selectedId = isAuto ? autoOversamplingItem : high > 0 ? firstHighOversamplingItem + high - 1 : choice + 1;
+    const juce::String text = isAuto ? "Auto (" + juce::String(governor.getFactor()) + "x)" : "Auto";
+    const auto reason = isAuto ? Aetheri::OversamplingGovernor::getReasonText(governor.getReason()) : juce::String();
+    
+    if (text == lastOversamplingText && reason == lastOversamplingReason && selectedId == oversamplingSelector.getSelectedId())
+        return;
+    
+    lastOversamplingText = text;
+    lastOversamplingReason = reason;
+    
+    oversamplingSelector.changeItemText(autoOversamplingItem, text);
+    
+    if (isAuto)
+    {
+        oversamplingSelector.setText(text, juce::dontSendNotification);
+        oversamplingSelector.setTooltip("Oversampling: Auto picks the factor from the saturation settings and level - "
+                                        + juce::String(governor.getFactor()) + "x for " + reason);
+    }
+    else
+    {
+        oversamplingSelector.setSelectedId(selectedId, juce::dontSendNotification);
+        oversamplingSelector.setTooltip("Oversampling: Higher rates reduce aliasing but increase CPU usage");
+    }
+}
+
 void AetheriAudioProcessorEditor::updateChannelLabels()
 {
     // Check if we're in M/S mode
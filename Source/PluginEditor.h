@@ -92,8 +92,19 @@ private:
     Aetheri::PhaseCorrelationMeter phaseCorrMeter;
     
     // Oversampling
+    // Selector items 1x-4x, 8x/16x, then Auto, which shows the factor the governor picked
+    static constexpr int firstHighOversamplingItem = 4;
+    static constexpr int autoOversamplingItem = 6;
     juce::ComboBox oversamplingSelector;
-    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingAttachment;
+    juce::ComboBox oversamplingFilterSelector;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingFilterAttachment;
+    juce::String lastOversamplingText, lastOversamplingReason;  // Auto item as last shown
+    
+    // Linear-phase EQ
+    juce::ToggleButton linearPhaseButton;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> linearPhaseAttachment;
+    juce::ToggleButton ecoPrecisionButton;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> ecoPrecisionAttachment;
     
     // Auto-gain compensation
     juce::ToggleButton autoGainButton;
@@ -118,9 +129,12 @@ private:
     void setupFilterSection();
     void setupPresetSelector();
     void updateChannelLabels();
-    void updateVUMeters();
+    void updateVUMeters(const Aetheri::MeterSnapshot& meters);
     void updateNebulaEnergies();
-    void updateTubeGlow();
+    void updateTubeGlow(const Aetheri::MeterSnapshot& meters);
+    void updateOversamplingDisplay();
+    void oversamplingSelected();
+    void setParameterFromEditor(const juce::String& parameterID, float plainValue);
     void updatePresetList();
     void updateABButtonLabel();
     void setupOversamplingControls();
@@ -9,6 +9,8 @@
 #include "PluginEditor.h"
 #include "Utils/Presets.h"
 
+namespace ParamIndex = Aetheri::ParamIndex;
+
 AetheriAudioProcessor::AetheriAudioProcessor()
     : AudioProcessor(BusesProperties()
                      .withInput("Input", juce::AudioChannelSet::stereo(), true)
@@ -19,57 +21,20 @@ AetheriAudioProcessor::AetheriAudioProcessor()
     // Initialize factory presets on construction
     Aetheri::PresetManager::createFactoryPresets();
     
-    // Cache parameter pointers for efficient access
-    inputGainParam = parameters.getRawParameterValue(Aetheri::ParamIDs::inputGain);
-    outputTrimParam = parameters.getRawParameterValue(Aetheri::ParamIDs::outputTrim);
-    stereoModeParam = parameters.getRawParameterValue(Aetheri::ParamIDs::stereoMode);
-    channelLinkParam = parameters.getRawParameterValue(Aetheri::ParamIDs::channelLink);
-    
-    hpfEnabledParam = parameters.getRawParameterValue(Aetheri::ParamIDs::hpfEnabled);
-    hpfFreqParam = parameters.getRawParameterValue(Aetheri::ParamIDs::hpfFreq);
-    lpfEnabledParam = parameters.getRawParameterValue(Aetheri::ParamIDs::lpfEnabled);
-    lpfFreqParam = parameters.getRawParameterValue(Aetheri::ParamIDs::lpfFreq);
-    
-    hystEnabledParam = parameters.getRawParameterValue(Aetheri::ParamIDs::hystEnabled);
-    tubeHarmonicsParam = parameters.getRawParameterValue(Aetheri::ParamIDs::tubeHarmonics);
-    transformerSatParam = parameters.getRawParameterValue(Aetheri::ParamIDs::transformerSat);
-    hystMixParam = parameters.getRawParameterValue(Aetheri::ParamIDs::hystMix);
-    oversamplingParam = parameters.getRawParameterValue(Aetheri::ParamIDs::oversampling);
-    autoGainCompParam = parameters.getRawParameterValue(Aetheri::ParamIDs::autoGainComp);
-    bypassParam = parameters.getRawParameterValue(Aetheri::ParamIDs::bypass);
-    
-    // Cache band parameters
-    for (int band = 0; band < 4; ++band)
+    // Every registry parameter is listened to in registry order, so its tracker index is its ParamIndex
+    for (size_t index = 0; index < Aetheri::parameterTable.size(); ++index)
     {
-        for (int ch = 0; ch < 2; ++ch)
-        {
-            bandGainParams[band][ch] = parameters.getRawParameterValue(
-                Aetheri::ParamIDs::bandGain(band, ch));
-            bandTrimParams[band][ch] = parameters.getRawParameterValue(
-                Aetheri::ParamIDs::bandTrim(band, ch));
-            bandFreqParams[band][ch] = parameters.getRawParameterValue(
-                Aetheri::ParamIDs::bandFreq(band, ch));
-            bandEnabledParams[band][ch] = parameters.getRawParameterValue(
-                Aetheri::ParamIDs::bandEnabled(band, ch));
-            bandSoloParams[band][ch] = parameters.getRawParameterValue(
-                Aetheri::ParamIDs::bandSolo(band, ch));
-            bandMuteParams[band][ch] = parameters.getRawParameterValue(
-                Aetheri::ParamIDs::bandMute(band, ch));
-        }
+        const int tracked = parameterChanges.track(Aetheri::parameterTable[index].id.chars);
+        jassert(tracked == static_cast<int>(index));
+        juce::ignoreUnused(tracked);
     }
     
-    // Curve params only for LF (band 0) and HF (band 3)
-    for (int ch = 0; ch < 2; ++ch)
-    {
-        bandCurveParams[0][ch] = parameters.getRawParameterValue(
-            Aetheri::ParamIDs::bandCurve(0, ch));
-        bandCurveParams[1][ch] = parameters.getRawParameterValue(
-            Aetheri::ParamIDs::bandCurve(3, ch));
-    }
+    startTimerHz(messageThreadPollHz);
 }
 
 AetheriAudioProcessor::~AetheriAudioProcessor()
 {
+    stopTimer();
 }
 
 const juce::String AetheriAudioProcessor::getName() const
@@ -94,7 +59,9 @@ bool AetheriAudioProcessor::isMidiEffect() const
 
 double AetheriAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // Latency plus the decay of the filters and saturation as configured, from the audio thread
+    const double sampleRate = getSampleRate();
+    return sampleRate > 0.0 ? tailSamples.load(std::memory_order_relaxed) / sampleRate : 0.0;
 }
 
 int AetheriAudioProcessor::getNumPrograms()
@@ -307,56 +274,48 @@ bool AetheriAudioProcessor::importPreset(const juce::File& file)
     return true;
 }
 
-void AetheriAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+void AetheriAudioProcessor::prepareToPlay(double sampleRate, int /*samplesPerBlock*/)
 {
-    // Update oversampling factor
-    int osFactor = 1;  // Default to 1x
-    if (oversamplingParam != nullptr)
-    {
-        osFactor = static_cast<int>(oversamplingParam->load()) + 1;  // 0=1x, 1=2x, 2=4x
-    }
-    
-    if (osFactor != oversamplingFactor || oversampler == nullptr)
-    {
-        oversamplingFactor = osFactor;
-        
-        // Create oversampler with appropriate stages
-        int numStages = (osFactor == 2) ? 1 : (osFactor == 4) ? 2 : 0;
-        if (numStages > 0)
-        {
-            oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
-                2, numStages, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
-            oversampler->initProcessing(static_cast<size_t>(samplesPerBlock));
-        }
-        else
-        {
-            oversampler.reset();
-        }
-    }
+    // Start on the chosen oversampling factor and filter without a fade (Auto assumes a
+    // full-scale input until it has heard some)
+    oversamplingGovernor.prepare(sampleRate);
+    oversamplingGovernor.reset(getGovernorSettings());
+    renderProfileActive = isRenderProfileRequested();
+    oversamplingFactor = renderProfileActive ? renderProfile.oversamplingFactor : getRequestedOversamplingFactor();
+    oversamplingFilter = getRequestedOversamplingFilter();
+    oversamplingFadeGain = 1.0f;
+    oversamplingFadeStep = 1.0f / static_cast<float>(std::max(1, juce::roundToInt(sampleRate * 0.005)));  // 5ms each way
     
-    if (oversampler != nullptr)
+    // The host picks the precision before preparing; the other path's resamplers are released
+    if (isUsingDoublePrecision())
     {
-        oversampler->reset();
+        prepareState(doubleState);
+        floatState.release();
     }
-
-    // Report latency to host (oversampling introduces latency)
-    int reportedLatency = 0;
-    if (oversampler != nullptr)
+    else
     {
-        reportedLatency = static_cast<int>(oversampler->getLatencyInSamples());
+        prepareState(floatState);
+        doubleState.release();
     }
-    setLatencySamples(reportedLatency);
+    saturationWasSkipped = false;
 
-    // Prepare all DSP processors
-    // Note: Oversampling is handled by the oversampler class, which upsamples before processing
-    // and downsamples after. The DSP processors work at the base rate.
-    passiveEQ.prepare(sampleRate, samplesPerBlock);
-    hysteresis.prepare(sampleRate, samplesPerBlock);
-    filterSection.prepare(sampleRate, samplesPerBlock);
+    // Prepare all DSP processors for sub-blocks, whatever the host's buffer size
+    // Note: Only the hysteresis is oversampled - the filters and EQ work at the base rate
+    passiveEQ.prepare(sampleRate, subBlockSize);
+    hysteresis.prepare(sampleRate, subBlockSize * oversamplingFactor);
+    hysteresis.setOversampling(sampleRate, oversamplingFactor);
+    filterSection.prepare(sampleRate, subBlockSize);
+    setRenderProfileActive(renderProfileActive);
+    
+    // Designs for the new rate, in place before the first block
+    designSampleRate = sampleRate;
+    applyCoefficientSnapshot(designCoefficientSnapshot(), true);
     
     // Prepare VU meters (at original rate)
     inputVU.prepare(sampleRate);
     outputVU.prepare(sampleRate);
+    outputVU.setCorrelationEnabled(true);  // Drives the phase correlation meter
+    bandAnalyser.prepare(sampleRate);
     
     // Auto-gain compensation
     autoGainAdjustment.reset(sampleRate, 0.05);  // 50ms smoothing
@@ -364,7 +323,273 @@ void AetheriAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     referenceLevel = 0.0f;
     
     // Initialize DSP processors with current parameter values
+    parameterChanges.markAllDirty();
     updateDSPFromParameters();
+    processingChain.invalidate();
+    samplesUntilControlUpdate = 0;
+    silentInputSamples = 0;
+    sleeping = false;
+    matchedChannelSamples = 0;
+    processingChain.setChannelsIdentical(false);
+    
+    // Report latency to host (oversampling and the linear-phase EQ introduce latency)
+    updateReportedLatency();
+}
+
+template <typename SampleType>
+void AetheriAudioProcessor::prepareState(PrecisionState<SampleType>& state)
+{
+    // Resamplers for both filter designs, built once - they work through any block in
+    // fixed-size chunks, and the half-band designs are normalised, so a new block size or
+    // sample rate just clears their state
+    int maxLatency = 0;
+    
+    for (auto design : { Aetheri::OversamplingFilter::MinimumLatencyIIR, Aetheri::OversamplingFilter::LinearPhaseFIR })
+    {
+        auto& oversampler = state.oversamplers[static_cast<size_t>(design)];
+        
+        if (oversampler == nullptr)
+            oversampler = std::make_unique<Aetheri::PolyphaseOversampler<SampleType>>(design);
+        
+        oversampler->reset();
+        maxLatency = std::max(maxLatency, oversampler->getLatencySamples(maxOversamplingStages));
+    }
+    
+    // Delay path while the saturation is skipped, able to match any factor's latency, plus
+    // enough history to re-prime a resampler
+    state.saturationBypass.prepare(2, subBlockSize, maxLatency, 256);
+    setActiveOversampling(state, oversamplingFactor, oversamplingFilter);
+}
+
+template <typename SampleType>
+void AetheriAudioProcessor::setActiveOversampling(PrecisionState<SampleType>& state, int factor,
+                                                  Aetheri::OversamplingFilter design)
+{
+    auto* oversampler = state.getOversampler(design);
+    oversampler->setNumStages(stagesForFactor(factor));
+    
+    oversamplingFactor = factor;
+    oversamplingFilter = design;
+    resamplerLatency = oversampler->getLatencySamples();
+    state.saturationBypass.setLatency(resamplerLatency);
+}
+
+template <typename SampleType>
+void AetheriAudioProcessor::switchOversampling(PrecisionState<SampleType>& state, int factor,
+                                               Aetheri::OversamplingFilter design)
+{
+    // Called once the old setting has faded out, so the new one starts from silence
+    setActiveOversampling(state, factor, design);
+    hysteresis.setOversampling(getSampleRate(), oversamplingFactor);
+    primeOversampler(state);
+    
+    requestLatencyUpdate();
+    updateTailLength();
+}
+
+template <typename SampleType>
+void AetheriAudioProcessor::applyOversamplingFade(const juce::dsp::AudioBlock<SampleType>& block, bool fadingOut)
+{
+    const float target = fadingOut ? 0.0f : 1.0f;
+    
+    if (oversamplingFadeGain == target)
+        return;
+    
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const float step = fadingOut ? -oversamplingFadeStep : oversamplingFadeStep;
+    float gain = oversamplingFadeGain;
+    
+    for (int i = 0; i < numSamples; ++i)
+    {
+        gain = fadingOut ? std::max(target, gain + step) : std::min(target, gain + step);
+        
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            block.getChannelPointer(ch)[i] *= static_cast<SampleType>(gain);
+    }
+    
+    oversamplingFadeGain = gain;
+}
+
+bool AetheriAudioProcessor::isOversamplingChangeRequested() const
+{
+    const bool renderRequested = isRenderProfileRequested();
+    const int requestedFactor = renderRequested ? renderProfile.oversamplingFactor : getRequestedOversamplingFactor();
+    
+    return requestedFactor != oversamplingFactor
+        || (getRequestedOversamplingFilter() != oversamplingFilter && oversamplingFactor > 1)
+        || renderRequested != renderProfileActive;
+}
+
+bool AetheriAudioProcessor::isOversamplingAuto() const
+{
+    return isParameterOn(ParamIndex::oversamplingAuto);
+}
+
+int AetheriAudioProcessor::getRequestedOversamplingFactor() const
+{
+    // Auto overrides both choices, and 8x/16x (0=Off, 1=8x, 2=16x) override 1x/2x/4x
+    if (isOversamplingAuto())
+        return oversamplingGovernor.getFactor();
+    
+    const int high = static_cast<int>(getParameterValue(ParamIndex::highOversampling));
+    
+    if (high > 0)
+        return 4 << juce::jlimit(1, maxOversamplingStages - 2, high);
+    
+    const int choice = static_cast<int>(getParameterValue(ParamIndex::oversampling));
+    return 1 << juce::jlimit(0, 2, choice);
+}
+
+Aetheri::OversamplingFilter AetheriAudioProcessor::getRequestedOversamplingFilter() const
+{
+    // 0=IIR, 1=FIR
+    const bool fir = isParameterOn(ParamIndex::oversamplingFilter);
+    return fir ? Aetheri::OversamplingFilter::LinearPhaseFIR : Aetheri::OversamplingFilter::MinimumLatencyIIR;
+}
+
+Aetheri::OversamplingGovernor::Settings AetheriAudioProcessor::getGovernorSettings() const
+{
+    Aetheri::OversamplingGovernor::Settings settings;
+    settings.enabled = isParameterOn(ParamIndex::hystEnabled);
+    settings.tube = getParameterValue(ParamIndex::tubeHarmonics) / 100.0f;
+    settings.transformer = getParameterValue(ParamIndex::transformerSat) / 100.0f;
+    settings.mix = getParameterValue(ParamIndex::hystMix) / 100.0f;
+    return settings;
+}
+
+bool AetheriAudioProcessor::isRenderProfileRequested() const
+{
+    return isNonRealtime() && isParameterOn(ParamIndex::renderQuality);
+}
+
+void AetheriAudioProcessor::setRenderProfileActive(bool shouldBeActive)
+{
+    renderProfileActive = shouldBeActive;
+    
+    const int controlInterval = renderProfileActive ? renderProfile.controlInterval : Aetheri::ControlRate::defaultInterval;
+    passiveEQ.setControlInterval(controlInterval);
+    filterSection.setControlInterval(controlInterval);
+    updateEngine();
+}
+
+int AetheriAudioProcessor::calculateTotalLatency() const
+{
+    // Only the saturation is oversampled; the EQ's delay is at the host rate
+    return resamplerLatency + passiveEQ.getLatencySamples();
+}
+
+void AetheriAudioProcessor::updateTailLength()
+{
+    // The delays, then each stage's decay in turn; the linear-phase FIR carries the HPF/LPF,
+    // and the resampler's filters spread about as far again as its delay
+    int tail = calculateTotalLatency() + resamplerLatency
+             + passiveEQ.getTailSamples(tailAttenuation)
+             + hysteresis.getTailSamples(tailAttenuation);
+    
+    if (passiveEQ.getEngine() != Aetheri::PassiveEQ::Engine::LinearPhase)
+        tail += filterSection.getTailSamples(tailAttenuation);
+    
+    tailSamples.store(tail, std::memory_order_relaxed);
+}
+
+void AetheriAudioProcessor::updateReportedLatency()
+{
+    const int totalLatency = calculateTotalLatency();
+    pendingLatency = totalLatency;
+    
+    if (totalLatency != getLatencySamples())
+        setLatencySamples(totalLatency);
+}
+
+void AetheriAudioProcessor::requestLatencyUpdate()
+{
+    // Picked up by timerCallback(); the host is only told (and asked to restart) if the
+    // total really changed
+    pendingLatency = calculateTotalLatency();
+}
+
+void AetheriAudioProcessor::timerCallback()
+{
+    // Filter designs asked for by the audio thread
+    if (coefficientDesignPending.exchange(false))
+        coefficientSnapshots.publish(designCoefficientSnapshot());
+    
+    const int totalLatency = pendingLatency.load();
+    
+    if (totalLatency != getLatencySamples())
+        setLatencySamples(totalLatency);
+}
+
+Aetheri::EQBand::CurveType AetheriAudioProcessor::getBandCurve(int band, int channel) const
+{
+    // Only LF (band 0) and HF (band 3) switch between Bell and Shelf
+    if (band != 0 && band != 3)
+        return Aetheri::EQBand::CurveType::Bell;
+    
+    return isParameterOn(ParamIndex::bandCurve(band, channel)) ? Aetheri::EQBand::CurveType::Shelf
+                                                                       : Aetheri::EQBand::CurveType::Bell;
+}
+
+Aetheri::CoefficientTargets AetheriAudioProcessor::getCoefficientTargets() const
+{
+    Aetheri::CoefficientTargets targets;
+    targets.sampleRate = designSampleRate.load();
+    
+    // If channels are linked, both channels are designed from channel 0
+    const bool channelsLinked = isParameterOn(ParamIndex::channelLink);
+    
+    for (int ch = 0; ch < Aetheri::CoefficientTargets::numChannels; ++ch)
+    {
+        const int sourceCh = channelsLinked ? 0 : ch;
+        
+        for (int band = 0; band < Aetheri::CoefficientTargets::numBands; ++band)
+        {
+            const float freq = getParameterValue(ParamIndex::bandFreq(band, sourceCh));
+            const float gain = getParameterValue(ParamIndex::bandGain(band, sourceCh))
+                             + getParameterValue(ParamIndex::bandTrim(band, sourceCh));
+            
+            targets.bands[static_cast<size_t>(ch)][static_cast<size_t>(band)]
+                = Aetheri::EQBand::makeKey(targets.sampleRate, getBandCurve(band, sourceCh), freq, gain,
+                                           Aetheri::BandDefaults::getQ(band));
+        }
+    }
+    
+    targets.highPassFrequency = getParameterValue(ParamIndex::hpfFreq);
+    targets.lowPassFrequency = getParameterValue(ParamIndex::lpfFreq);
+    return targets;
+}
+
+Aetheri::CoefficientSnapshot AetheriAudioProcessor::designCoefficientSnapshot()
+{
+    // Generation first, parameters second: a later generation never holds older values
+    const auto generation = coefficientGeneration.fetch_add(1) + 1;
+    return Aetheri::CoefficientSnapshot::design(getCoefficientTargets(), *coefficientCache, generation);
+}
+
+void AetheriAudioProcessor::applyCoefficientSnapshot(const Aetheri::CoefficientSnapshot& snapshot, bool snap)
+{
+    // A snapshot overtaken by a newer design (e.g. one made in prepareToPlay) is dropped
+    if (!snap && snapshot.generation <= appliedCoefficientGeneration)
+        return;
+    
+    appliedCoefficientGeneration = snapshot.generation;
+    passiveEQ.setCoefficientTargets(snapshot, snap);
+    filterSection.setTargetCoefficients(snapshot.highPass, snapshot.lowPass, snap);
+    updateTailLength();
+}
+
+void AetheriAudioProcessor::requestCoefficientDesign()
+{
+    // Offline there is no deadline, and waiting on the message thread would make the
+    // result depend on its timing
+    if (isNonRealtime())
+    {
+        applyCoefficientSnapshot(designCoefficientSnapshot(), false);
+        return;
+    }
+    
+    // Designed and published by timerCallback()
+    coefficientDesignPending = true;
 }
 
 void AetheriAudioProcessor::releaseResources()
@@ -390,7 +615,7 @@ bool AetheriAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) c
 
 float AetheriAudioProcessor::calculateAutoGainAdjustment()
 {
-    if (autoGainCompParam == nullptr || autoGainCompParam->load() < 0.5f)
+    if (!isParameterOn(ParamIndex::autoGainComp))
         return 0.0f;  // Auto-gain disabled
     
     // Calculate current output level
@@ -415,97 +640,70 @@ float AetheriAudioProcessor::calculateAutoGainAdjustment()
     return 0.0f;
 }
 
-void AetheriAudioProcessor::calculatePhaseCorrelation(const juce::AudioBuffer<float>& buffer)
+void AetheriAudioProcessor::updateDSPFromParameters()
 {
-    if (buffer.getNumChannels() < 2)
-    {
-        phaseCorrelation = 0.0f;
-        return;
-    }
+    // Oversampling changes are picked up in processSubBlock(), which fades between settings
     
-    const float* left = buffer.getReadPointer(0);
-    const float* right = buffer.getReadPointer(1);
-    int numSamples = buffer.getNumSamples();
+    // Only parameters whose listeners fired since the last block are applied; auto-gain
+    // follows the output meter, so it runs every block while it is on
+    // Newest filter designs from the message thread
+    if (auto* snapshot = coefficientSnapshots.fetch())
+        applyCoefficientSnapshot(*snapshot, false);
     
-    float sumL = 0.0f, sumR = 0.0f, sumLR = 0.0f, sumL2 = 0.0f, sumR2 = 0.0f;
+    Aetheri::ParameterChangeTracker::Changes changes;
+    const bool changed = parameterChanges.collect(changes);
+    const bool autoGain = isParameterOn(ParamIndex::autoGainComp);
     
-    for (int i = 0; i < numSamples; ++i)
-    {
-        float l = left[i];
-        float r = right[i];
-        
-        sumL += l;
-        sumR += r;
-        sumLR += l * r;
-        sumL2 += l * l;
-        sumR2 += r * r;
-    }
+    if (!changed && !autoGain)
+        return;
     
-    // Calculate correlation coefficient
-    float meanL = sumL / numSamples;
-    float meanR = sumR / numSamples;
-    float covLR = (sumLR / numSamples) - (meanL * meanR);
-    float varL = (sumL2 / numSamples) - (meanL * meanL);
-    float varR = (sumR2 / numSamples) - (meanR * meanR);
+    // Input/Output gains (with auto-gain compensation)
+    if (autoGain || changes.test(ParamIndex::inputGain) || changes.test(ParamIndex::autoGainComp))
+        passiveEQ.setInputGain(getParameterValue(ParamIndex::inputGain) + calculateAutoGainAdjustment());
+    if (changes.test(ParamIndex::outputTrim))
+        passiveEQ.setOutputTrim(getParameterValue(ParamIndex::outputTrim));
     
-    float denom = std::sqrt(varL * varR);
-    if (denom > 0.0001f)
-    {
-        phaseCorrelation = covLR / denom;
-    }
-    else
-    {
-        phaseCorrelation = 0.0f;
-    }
-}
-
-void AetheriAudioProcessor::updateDSPFromParameters()
-{
-    // Note: Oversampling changes are handled in prepareToPlay() - we don't update
-    // the oversampler here to avoid thread safety issues. The oversampling factor
-    // will be updated on the next prepareToPlay() call.
-    // For now, just read the current value (it will be applied in prepareToPlay)
-    if (oversamplingParam != nullptr)
-    {
-        int newOSFactor = static_cast<int>(oversamplingParam->load()) + 1;
-        // Only update the factor if it changed - actual oversampler update happens in prepareToPlay
-        if (newOSFactor != oversamplingFactor)
-        {
-            oversamplingFactor = newOSFactor;
-            // Note: We can't safely re-initialize oversampler from audio thread
-            // It will be updated in the next prepareToPlay() call
-        }
-    }
+    if (!changed)
+        return;
     
-    // Auto-gain compensation adjustment
-    float autoGainAdj = calculateAutoGainAdjustment();
-    float baseInputGain = inputGainParam->load();
-    float baseOutputTrim = outputTrimParam->load();
-    
-    // Input/Output gains (with auto-gain compensation)
-    passiveEQ.setInputGain(baseInputGain + autoGainAdj);
-    passiveEQ.setOutputTrim(baseOutputTrim);
+    if (changes.test(ParamIndex::linearPhase) || changes.test(ParamIndex::ecoPrecision) || changes.test(ParamIndex::eqEngine))
+        updateEngine();
     
     // Stereo mode
-    bool isMidSide = stereoModeParam->load() > 0.5f;
-    passiveEQ.setStereoMode(isMidSide);
-    passiveEQ.setChannelLink(channelLinkParam->load() > 0.5f);
+    if (changes.test(ParamIndex::stereoMode))
+        passiveEQ.setStereoMode(isParameterOn(ParamIndex::stereoMode));
+    
+    // Linking switches every band over to channel 0's values (or back)
+    const bool linkChanged = changes.test(ParamIndex::channelLink);
+    const bool channelsLinked = isParameterOn(ParamIndex::channelLink);
+    
+    if (linkChanged)
+        passiveEQ.setChannelLink(channelsLinked);
+    
+    // Gain, trim, frequency, curve or link changes need new designs
+    bool designChanged = linkChanged || changes.test(ParamIndex::hpfFreq) || changes.test(ParamIndex::lpfFreq);
     
     // HPF/LPF
-    filterSection.setHPFEnabled(hpfEnabledParam->load() > 0.5f);
-    filterSection.setHPFFrequency(hpfFreqParam->load());
-    filterSection.setLPFEnabled(lpfEnabledParam->load() > 0.5f);
-    filterSection.setLPFFrequency(lpfFreqParam->load());
+    if (changes.test(ParamIndex::hpfEnabled))
+        filterSection.setHPFEnabled(isParameterOn(ParamIndex::hpfEnabled));
+    if (changes.test(ParamIndex::hpfFreq))
+        filterSection.setHPFFrequency(getParameterValue(ParamIndex::hpfFreq));
+    if (changes.test(ParamIndex::lpfEnabled))
+        filterSection.setLPFEnabled(isParameterOn(ParamIndex::lpfEnabled));
+    if (changes.test(ParamIndex::lpfFreq))
+        filterSection.setLPFFrequency(getParameterValue(ParamIndex::lpfFreq));
     
     // Hysteresis
-    hysteresis.setEnabled(hystEnabledParam->load() > 0.5f);
-    hysteresis.setTubeHarmonics(tubeHarmonicsParam->load());
-    hysteresis.setTransformerSaturate(transformerSatParam->load());
-    hysteresis.setMix(hystMixParam->load());
+    if (changes.test(ParamIndex::hystEnabled))
+        hysteresis.setEnabled(isParameterOn(ParamIndex::hystEnabled));
+    if (changes.test(ParamIndex::tubeHarmonics))
+        hysteresis.setTubeHarmonics(getParameterValue(ParamIndex::tubeHarmonics));
+    if (changes.test(ParamIndex::transformerSat))
+        hysteresis.setTransformerSaturate(getParameterValue(ParamIndex::transformerSat));
+    if (changes.test(ParamIndex::hystMix))
+        hysteresis.setMix(getParameterValue(ParamIndex::hystMix));
     
     // EQ Bands
-    bool channelsLinked = channelLinkParam->load() > 0.5f;
-    
     for (int band = 0; band < 4; ++band)
     {
         for (int ch = 0; ch < 2; ++ch)
@@ -513,40 +711,85 @@ void AetheriAudioProcessor::updateDSPFromParameters()
             // If channels are linked, use channel 0 values for both channels
             int sourceCh = channelsLinked ? 0 : ch;
             
-            float gain = bandGainParams[band][sourceCh]->load();
-            float trim = bandTrimParams[band][sourceCh]->load();
-            float freq = bandFreqParams[band][sourceCh]->load();
-            bool enabled = bandEnabledParams[band][sourceCh]->load() > 0.5f;
+            // Curve type only exists for LF (band 0) and HF (band 3)
+            const int curveIndex = ParamIndex::bandCurve(band, sourceCh);
             
-            Aetheri::EQBand::CurveType curve = Aetheri::EQBand::CurveType::Bell;
+            const bool bandDesignChanged = changes.test(ParamIndex::bandGain(band, sourceCh))
+                                        || changes.test(ParamIndex::bandTrim(band, sourceCh))
+                                        || changes.test(ParamIndex::bandFreq(band, sourceCh))
+                                        || (curveIndex >= 0 && changes.test(curveIndex));
+            designChanged = designChanged || bandDesignChanged;
             
-            // Get curve type for LF (band 0) and HF (band 3)
-            if (band == 0)
-            {
-                curve = bandCurveParams[0][sourceCh]->load() > 0.5f ? 
-                        Aetheri::EQBand::CurveType::Shelf : 
-                        Aetheri::EQBand::CurveType::Bell;
-            }
-            else if (band == 3)
+            if (linkChanged || bandDesignChanged || changes.test(ParamIndex::bandEnabled(band, sourceCh)))
             {
-                curve = bandCurveParams[1][sourceCh]->load() > 0.5f ? 
-                        Aetheri::EQBand::CurveType::Shelf : 
-                        Aetheri::EQBand::CurveType::Bell;
+                float gain = getParameterValue(ParamIndex::bandGain(band, sourceCh));
+                float trim = getParameterValue(ParamIndex::bandTrim(band, sourceCh));
+                float freq = getParameterValue(ParamIndex::bandFreq(band, sourceCh));
+                bool enabled = isParameterOn(ParamIndex::bandEnabled(band, sourceCh));
+                
+                passiveEQ.setBandParameters(band, ch, freq, gain, trim, getBandCurve(band, sourceCh), enabled);
+                bandAnalyser.setBandFrequency(band, ch, freq);
             }
             
-            passiveEQ.setBandParameters(band, ch, freq, gain, trim, curve, enabled);
-            
             // Solo/Mute
-            bool solo = bandSoloParams[band][sourceCh]->load() > 0.5f;
-            bool mute = bandMuteParams[band][sourceCh]->load() > 0.5f;
-            passiveEQ.setBandSolo(band, ch, solo);
-            passiveEQ.setBandMute(band, ch, mute);
+            if (linkChanged || changes.test(ParamIndex::bandSolo(band, sourceCh)))
+                passiveEQ.setBandSolo(band, ch, isParameterOn(ParamIndex::bandSolo(band, sourceCh)));
+            if (linkChanged || changes.test(ParamIndex::bandMute(band, sourceCh)))
+                passiveEQ.setBandMute(band, ch, isParameterOn(ParamIndex::bandMute(band, sourceCh)));
         }
     }
+    
+    updateTailLength();
+    
+    if (designChanged)
+        requestCoefficientDesign();
+}
+
+Aetheri::PassiveEQ::Engine AetheriAudioProcessor::getChosenEQEngine() const
+{
+    // 0=Serial, 1=Parallel, 2=Reference
+    switch (static_cast<int>(getParameterValue(ParamIndex::eqEngine)))
+    {
+        case 1:   return Aetheri::PassiveEQ::Engine::Parallel;
+        case 2:   return Aetheri::PassiveEQ::Engine::Reference;
+        default:  return Aetheri::PassiveEQ::Engine::Vectorised;
+    }
+}
+
+void AetheriAudioProcessor::updateEngine()
+{
+    // Linear-phase mode swaps the EQ engine and changes the reported latency;
+    // eco precision runs the minimum-phase EQ and the HPF/LPF in 32-bit SVF form
+    // (the render profile keeps them at 64 bits). Otherwise the EQ Engine choice
+    // picks the serial cascade, its parallel form or the per-band reference path
+    bool ecoPrecision = isParameterOn(ParamIndex::ecoPrecision) && !(renderProfileActive && renderProfile.fullPrecision);
+    auto engine = isParameterOn(ParamIndex::linearPhase) ? Aetheri::PassiveEQ::Engine::LinearPhase
+                : ecoPrecision                    ? Aetheri::PassiveEQ::Engine::Eco
+                                                  : getChosenEQEngine();
+    filterSection.setEcoPrecision(ecoPrecision);
+    
+    if (engine != passiveEQ.getEngine())
+    {
+        passiveEQ.setEngine(engine);
+        requestLatencyUpdate();
+    }
 }
 
 void AetheriAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                           juce::MidiBuffer& /*midiMessages*/)
+{
+    processBlockImpl(buffer);
+}
+
+void AetheriAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer,
+                                          juce::MidiBuffer& /*midiMessages*/)
+{
+    // Native 64-bit path - the whole chain, resampler and meters run in double
+    processBlockImpl(buffer);
+}
+
+template <typename SampleType>
+void AetheriAudioProcessor::processBlockImpl(juce::AudioBuffer<SampleType>& buffer)
 {
     juce::ScopedNoDenormals noDenormals;
     
@@ -560,74 +803,174 @@ void AetheriAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     if (buffer.getNumChannels() < 2)
         return;
 
+    applyMeterModes();
+
     // Check bypass state - pass audio through unprocessed
-    if (bypassParam != nullptr && bypassParam->load() > 0.5f)
+    if (isParameterOn(ParamIndex::bypass))
     {
         // Still update meters for visual feedback even when bypassed
-        inputVU.pushSamples(buffer);
-        outputVU.pushSamples(buffer);
+        juce::dsp::AudioBlock<SampleType> block(buffer);
+        inputVU.pushSamples(block);
+        outputVU.pushSamples(block);
+        outputVU.updatePhaseCorrelation();
+        publishMeterTelemetry();
         return;
     }
+    
+    // Fixed-size sub-blocks over the host's memory, so a long host buffer never exceeds what
+    // was prepared and short ones don't each pay for a parameter update
+    const int numSamples = buffer.getNumSamples();
+    
+    for (int start = 0; start < numSamples; start += subBlockSize)
+    {
+        juce::AudioBuffer<SampleType> subBlock(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                               start, std::min(subBlockSize, numSamples - start));
+        processSubBlock(subBlock);
+    }
+    
+    // One correlation reading over the whole host block
+    outputVU.updatePhaseCorrelation();
+    publishMeterTelemetry();
+}
 
-    // Update DSP parameters
-    updateDSPFromParameters();
+template <typename SampleType>
+void AetheriAudioProcessor::processSubBlock(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto& state = getState(SampleType());
+    auto& saturationBypass = state.saturationBypass;
+    
+    // Everything below works in place on blocks over the host's (or the resampler's) memory
+    juce::dsp::AudioBlock<SampleType> block(buffer);
+    
+    // Parameters at a fixed control rate of one update per subBlockSize samples
+    if (samplesUntilControlUpdate <= 0)
+    {
+        updateDSPFromParameters();
+        processingChain.rebuild();
+        samplesUntilControlUpdate += subBlockSize;
+    }
+    
+    samplesUntilControlUpdate -= buffer.getNumSamples();
+    
+    // Asleep, silence in gives silence out without running the chain. A pending oversampling
+    // change wakes it, so the change fades through as usual on silence
+    const bool inputSilent = isSilent(buffer);
+    silentInputSamples = inputSilent ? silentInputSamples + buffer.getNumSamples() : 0;
     
-    // Measure input levels (before processing)
-    inputVU.pushSamples(buffer);
+    // Auto only ever lowers its factor while the signal plays; once the chain has decayed
+    // into silence it goes back to the settings' full-scale factor, where the fade is inaudible
+    const bool chainDecayed = inputSilent && silentInputSamples >= tailSamples.load(std::memory_order_relaxed);
     
-    // Oversampling: upsample if needed
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::AudioBlock<float> osBlock;
+    if (isOversamplingAuto() && chainDecayed)
+        oversamplingGovernor.reset(getGovernorSettings());
     
-    if (oversamplingFactor > 1 && oversampler != nullptr)
+    sleeping = sleeping && inputSilent && !isOversamplingChangeRequested();
+    
+    if (sleeping)
     {
-        osBlock = oversampler->processSamplesUp(block);
-        
-        // Create buffer from oversampled block
-        juce::AudioBuffer<float> processBuffer(static_cast<int>(osBlock.getNumChannels()),
-                                               static_cast<int>(osBlock.getNumSamples()));
-        for (int ch = 0; ch < processBuffer.getNumChannels(); ++ch)
-        {
-            processBuffer.copyFrom(ch, 0, osBlock.getChannelPointer(ch), processBuffer.getNumSamples());
-        }
-        
-        // Processing chain at oversampled rate:
-        // 1. HPF/LPF Filters
-        filterSection.processBlock(processBuffer);
+        buffer.clear();
+        inputVU.pushSamples(block);
+        outputVU.pushSamples(block);
+        bandAnalyser.pushSamples(buffer);
+        return;
+    }
+    
+    // Measure input levels (before processing), comparing the channels in the same pass
+    inputVU.pushSamples(block);
+    
+    // Once they have matched for the whole tail the right channel's state has converged
+    // on the left's, and it can follow it by copy until they part
+    const bool channelsMatched = inputVU.wereChannelsIdentical() && passiveEQ.areChannelsMatched();
+    matchedChannelSamples = channelsMatched ? matchedChannelSamples + buffer.getNumSamples() : 0;
+    processingChain.setChannelsIdentical(matchedChannelSamples > tailSamples.load(std::memory_order_relaxed));
+    
+    // HPF/LPF -> Passive EQ (input gain, M/S, output trim) at the host rate, live stages only
+    processingChain.processLinear(juce::dsp::ProcessContextReplacing<SampleType>(block));
+    
+    saturationBypass.pushInput(buffer);
+    
+    // Auto: the governor reads the signal on its way into the saturation
+    if (isOversamplingAuto() && !chainDecayed)
+        oversamplingGovernor.process(block, getGovernorSettings());
+    
+    // A new oversampling factor or filter takes over once the current one has faded out;
+    // the render profile comes and goes at the same silent point
+    bool switching = isOversamplingChangeRequested();
+    
+    if (switching && oversamplingFadeGain <= 0.0f)
+    {
+        const bool renderRequested = isRenderProfileRequested();
         
-        // 2. Passive EQ (includes input gain, M/S encoding, and output trim)
-        passiveEQ.processBlock(processBuffer);
+        if (renderRequested != renderProfileActive)
+            setRenderProfileActive(renderRequested);
         
-        // 3. Hysteresis Stage (parallel to EQ, applied after)
-        hysteresis.processBlock(processBuffer);
+        switchOversampling(state, renderRequested ? renderProfile.oversamplingFactor : getRequestedOversamplingFactor(),
+                           getRequestedOversamplingFilter());
+        switching = false;
+    }
+    
+    auto* oversampler = oversamplingFactor > 1 ? state.getOversampler(oversamplingFilter) : nullptr;
+    
+    if (!processingChain.hasSaturation())
+    {
+        // Nothing to saturate - skip the resampler and just keep the reported latency
+        saturationBypass.processDelayed(buffer);
+        saturationWasSkipped = true;
+    }
+    else if (oversampler != nullptr)
+    {
+        if (saturationWasSkipped)
+            primeOversampler(state);
         
-        // Copy back to oversampled block
-        for (int ch = 0; ch < processBuffer.getNumChannels(); ++ch)
+        // Hysteresis at the oversampled rate, chunk by chunk in place on the resampler's buffer
+        oversampler->process(block, [this](juce::dsp::AudioBlock<SampleType> oversampled)
         {
-            osBlock.getSingleChannelBlock(ch).copyFrom(processBuffer, ch, 0, processBuffer.getNumSamples());
-        }
-        
-        // Oversampling: downsample
-        oversampler->processSamplesDown(block);
+            processingChain.processSaturation(juce::dsp::ProcessContextReplacing<SampleType>(oversampled));
+        });
+        saturationWasSkipped = false;
     }
     else
     {
-        // Processing chain at normal rate:
-        // 1. HPF/LPF Filters
-        filterSection.processBlock(buffer);
-        
-        // 2. Passive EQ (includes input gain, M/S encoding, and output trim)
-        passiveEQ.processBlock(buffer);
-        
-        // 3. Hysteresis Stage (parallel to EQ, applied after)
-        hysteresis.processBlock(buffer);
+        processingChain.processSaturation(juce::dsp::ProcessContextReplacing<SampleType>(block));
+        saturationWasSkipped = false;
     }
     
-    // Calculate phase correlation (on output)
-    calculatePhaseCorrelation(buffer);
+    // Out ahead of a factor change, back in after it
+    applyOversamplingFade(block, switching);
+    
+    // Measure output levels and phase correlation in one pass
+    outputVU.pushSamples(block);
+    bandAnalyser.pushSamples(buffer);
+    
+    // The chain's state has had time to decay and the output agrees
+    sleeping = inputSilent && silentInputSamples >= tailSamples.load(std::memory_order_relaxed)
+            && oversamplingFadeGain >= 1.0f && isSilent(buffer);
+}
+
+template <typename SampleType>
+bool AetheriAudioProcessor::isSilent(const juce::AudioBuffer<SampleType>& buffer)
+{
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        if (buffer.getMagnitude(ch, 0, buffer.getNumSamples()) >= static_cast<SampleType>(silenceThreshold))
+            return false;
+    }
     
-    // Measure output levels
-    outputVU.pushSamples(buffer);
+    return true;
+}
+
+template <typename SampleType>
+void AetheriAudioProcessor::primeOversampler(PrecisionState<SampleType>& state)
+{
+    // The resampler sat idle while the saturation was skipped - run the recent input through
+    // it so its filters pick up where the latency-matched copy left off
+    auto& history = state.saturationBypass.getHistory();
+    
+    if (oversamplingFactor == 1 || history.getNumSamples() == 0)
+        return;
+    
+    state.getOversampler(oversamplingFilter)->process(juce::dsp::AudioBlock<SampleType>(history),
+                                                      [](juce::dsp::AudioBlock<SampleType>) {});
 }
 
 bool AetheriAudioProcessor::hasEditor() const
@@ -656,24 +999,48 @@ void AetheriAudioProcessor::setStateInformation(const void* data, int sizeInByte
     }
 }
 
-float AetheriAudioProcessor::getInputLevel(int channel) const
+float AetheriAudioProcessor::getBandEnergy(int band, int channel) const
 {
-    return passiveEQ.getInputLevel(channel);
+    return bandAnalyser.getEnergy(band, channel);
 }
 
-float AetheriAudioProcessor::getOutputLevel(int channel) const
+void AetheriAudioProcessor::setMeterModes(Aetheri::MeterMode inputMode, Aetheri::MeterMode outputMode)
 {
-    return passiveEQ.getOutputLevel(channel);
+    requestedInputMeterMode.store(static_cast<int>(inputMode), std::memory_order_relaxed);
+    requestedOutputMeterMode.store(static_cast<int>(outputMode), std::memory_order_relaxed);
 }
 
-float AetheriAudioProcessor::getBandEnergy(int band, int channel) const
+void AetheriAudioProcessor::applyMeterModes()
 {
-    return passiveEQ.getBandEnergy(band, channel);
+    // setMode() resets the meter, so a mode change starts from clean ballistics
+    const auto inputMode = static_cast<Aetheri::MeterMode>(requestedInputMeterMode.load(std::memory_order_relaxed));
+    const auto outputMode = static_cast<Aetheri::MeterMode>(requestedOutputMeterMode.load(std::memory_order_relaxed));
+    
+    if (inputVU.getMode() != inputMode)
+        inputVU.setMode(inputMode);
+    
+    if (outputVU.getMode() != outputMode)
+        outputVU.setMode(outputMode);
 }
 
-float AetheriAudioProcessor::getHysteresisGlowIntensity() const
+void AetheriAudioProcessor::publishMeterTelemetry()
 {
-    return hysteresis.getGlowIntensity();
+    Aetheri::MeterSnapshot snapshot;
+    
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        const auto& in = ch == 0 ? inputVU.getLeft() : inputVU.getRight();
+        const auto& out = ch == 0 ? outputVU.getLeft() : outputVU.getRight();
+        
+        snapshot.inputLevel[static_cast<size_t>(ch)] = in.getNormalizedLevel();
+        snapshot.inputPeak[static_cast<size_t>(ch)] = in.getNormalizedPeak();
+        snapshot.outputLevel[static_cast<size_t>(ch)] = out.getNormalizedLevel();
+        snapshot.outputPeak[static_cast<size_t>(ch)] = out.getNormalizedPeak();
+    }
+    
+    snapshot.phaseCorrelation = outputVU.getPhaseCorrelation();
+    snapshot.glowIntensity = hysteresis.getGlowIntensity();
+    meterTelemetry.publish(snapshot);
 }
 
 void AetheriAudioProcessor::saveCurrentToAB()
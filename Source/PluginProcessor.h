@@ -17,12 +17,20 @@
 #include <juce_dsp/juce_dsp.h>
 #include <juce_core/juce_core.h>
 #include "DSP/PassiveEQ.h"
+#include "DSP/CoefficientSnapshot.h"
 #include "DSP/HysteresisProcessor.h"
 #include "DSP/VUMeter.h"
 #include "DSP/HighLowPassFilters.h"
+#include "DSP/ProcessingChain.h"
+#include "DSP/PolyphaseOversampler.h"
+#include "DSP/OversamplingGovernor.h"
+#include "DSP/BandEnergyAnalyser.h"
 #include "Utils/Parameters.h"
+#include "Utils/ParameterChangeTracker.h"
+#include "Utils/MeterTelemetry.h"
 
-class AetheriAudioProcessor : public juce::AudioProcessor
+class AetheriAudioProcessor : public juce::AudioProcessor,
+                              private juce::Timer
 {
 public:
     AetheriAudioProcessor();
@@ -35,6 +43,8 @@ public:
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -74,21 +84,20 @@ public:
     juce::AudioProcessorValueTreeState& getParameters() { return parameters; }
     
     // Metering access (for UI)
-    float getInputLevel(int channel) const;
-    float getOutputLevel(int channel) const;
     float getBandEnergy(int band, int channel) const;
     
-    // VU Meters
-    const Aetheri::StereoVUMeter& getInputVU() const { return inputVU; }
-    const Aetheri::StereoVUMeter& getOutputVU() const { return outputVU; }
-    Aetheri::StereoVUMeter& getInputVU() { return inputVU; }
-    Aetheri::StereoVUMeter& getOutputVU() { return outputVU; }
+    // Band energy is only analysed while an editor displays it (message thread)
+    void setBandEnergyAnalysisEnabled(bool shouldAnalyse) { bandAnalyser.setEnabled(shouldAnalyse); }
     
-    // Hysteresis glow intensity
-    float getHysteresisGlowIntensity() const;
+    // VU levels, phase correlation and hysteresis glow, all from the same block
+    Aetheri::MeterSnapshot getMeterSnapshot() const { return meterTelemetry.read(); }
     
-    // Phase correlation (for meter)
-    float getPhaseCorrelation() const { return phaseCorrelation; }
+    // Any thread: the audio thread switches (and resets) the meters at its next block
+    void setMeterModes(Aetheri::MeterMode inputMode, Aetheri::MeterMode outputMode);
+    
+    // Auto oversampling: the governor's current factor and the reason for it
+    bool isOversamplingAuto() const;
+    const Aetheri::OversamplingGovernor& getOversamplingGovernor() const { return oversamplingGovernor; }
     
     // A/B Comparison methods
     void toggleAB();
@@ -103,35 +112,88 @@ private:
     Aetheri::HysteresisProcessor hysteresis;
     Aetheri::FilterSection filterSection;
     
+    // Live stages only; the resampler only runs around a live hysteresis stage
+    Aetheri::ProcessingChain processingChain { filterSection, passiveEQ, hysteresis };
+    bool saturationWasSkipped = false;
+    
+    // Host buffers run through the chain in sub-blocks of at most one resampler chunk, and
+    // parameters are applied once per sub-block's worth of samples whatever buffer size the
+    // host uses. Everything block-sized is prepared for this, so no host buffer can overrun it
+    static constexpr int subBlockSize = Aetheri::PolyphaseOversampler<float>::chunkSize;
+    int samplesUntilControlUpdate = 0;
+    
+    // Once the input has stayed silent for the chain's whole tail and the output has
+    // followed it down, the chain sleeps: sub-blocks are cleared instead of processed
+    // until signal returns. The frozen state has decayed below the threshold, so waking
+    // needs no reset
+    static constexpr float silenceThreshold = 1.0e-7f;  // -140 dBFS, under one 24-bit step
+    static constexpr double tailAttenuation = 1.0e-7;   // Full scale down to the threshold
+    int silentInputSamples = 0;
+    bool sleeping = false;
+    std::atomic<int> tailSamples { 0 };  // Also reported to the host as the tail length
+    
+    // Samples for which both input channels and the EQ settings of both sides have matched;
+    // past the tail the chain runs its per-channel stages once (mono sources on stereo tracks)
+    int matchedChannelSamples = 0;
+    
+    // Resamplers and dry path for one host precision - only the active one is allocated.
+    // Both filter designs are built up front so the choice can change during playback
+    static constexpr int maxOversamplingStages = Aetheri::PolyphaseOversampler<float>::maxStages;  // 1x - 16x
+    
+    static int stagesForFactor(int factor)
+    {
+        int stages = 0;
+        while (stages < maxOversamplingStages && (2 << stages) <= factor)
+            ++stages;
+        return stages;
+    }
+    
+    template <typename SampleType>
+    struct PrecisionState
+    {
+        // Indexed by filter design; each runs every factor from 2x to 16x
+        std::array<std::unique_ptr<Aetheri::PolyphaseOversampler<SampleType>>, 2> oversamplers;
+        Aetheri::LatencyMatchedBypass<SampleType> saturationBypass;
+        
+        Aetheri::PolyphaseOversampler<SampleType>* getOversampler(Aetheri::OversamplingFilter design) const
+        {
+            return oversamplers[static_cast<size_t>(design)].get();
+        }
+        
+        void release()
+        {
+            for (auto& oversampler : oversamplers)
+                oversampler.reset();
+        }
+    };
+    
+    PrecisionState<float> floatState;
+    PrecisionState<double> doubleState;
+    
+    PrecisionState<float>& getState(float) { return floatState; }
+    PrecisionState<double>& getState(double) { return doubleState; }
+    
     // Metering
     Aetheri::StereoVUMeter inputVU;
     Aetheri::StereoVUMeter outputVU;
+    Aetheri::BandEnergyAnalyser bandAnalyser;
+    
+    // The meters belong to the audio thread: modes arrive through these, readings leave
+    // through the telemetry once per host block
+    std::atomic<int> requestedInputMeterMode { static_cast<int>(Aetheri::MeterMode::RMS) };
+    std::atomic<int> requestedOutputMeterMode { static_cast<int>(Aetheri::MeterMode::RMS) };
+    Aetheri::MeterTelemetry meterTelemetry;
+    
+    void applyMeterModes();
+    void publishMeterTelemetry();
     
-    // Cached parameter values
-    std::atomic<float>* inputGainParam = nullptr;
-    std::atomic<float>* outputTrimParam = nullptr;
-    std::atomic<float>* stereoModeParam = nullptr;
-    std::atomic<float>* channelLinkParam = nullptr;
-    std::atomic<float>* hpfEnabledParam = nullptr;
-    std::atomic<float>* hpfFreqParam = nullptr;
-    std::atomic<float>* lpfEnabledParam = nullptr;
-    std::atomic<float>* lpfFreqParam = nullptr;
-    std::atomic<float>* hystEnabledParam = nullptr;
-    std::atomic<float>* tubeHarmonicsParam = nullptr;
-    std::atomic<float>* transformerSatParam = nullptr;
-    std::atomic<float>* hystMixParam = nullptr;
-    std::atomic<float>* oversamplingParam = nullptr;
-    std::atomic<float>* autoGainCompParam = nullptr;
-    std::atomic<float>* bypassParam = nullptr;
-    
-    // Band parameters [band][channel]
-    std::array<std::array<std::atomic<float>*, 2>, 4> bandGainParams;
-    std::array<std::array<std::atomic<float>*, 2>, 4> bandTrimParams;
-    std::array<std::array<std::atomic<float>*, 2>, 4> bandFreqParams;
-    std::array<std::array<std::atomic<float>*, 2>, 4> bandEnabledParams;
-    std::array<std::array<std::atomic<float>*, 2>, 4> bandSoloParams;
-    std::array<std::array<std::atomic<float>*, 2>, 4> bandMuteParams;
-    std::array<std::array<std::atomic<float>*, 2>, 2> bandCurveParams;  // Only LF and HF
+    // Listener-maintained values and change flags for every registry parameter, indexed by
+    // Aetheri::ParamIndex - one contiguous array read on the audio thread
+    Aetheri::ParameterChangeTracker parameterChanges { parameters };
+    static_assert(Aetheri::ParamIndex::count <= Aetheri::ParameterChangeTracker::maxParameters);
+    
+    float getParameterValue(int index) const { return parameterChanges.getValue(index); }
+    bool isParameterOn(int index) const { return getParameterValue(index) > 0.5f; }
     
     // Preset management
     int currentProgram = 0;
@@ -143,19 +205,94 @@ private:
     juce::ValueTree stateB;
     bool currentIsStateA = true;  // Currently viewing state A
     
-    // Oversampling
+    // Oversampling - the active factor and filter; a new choice takes over once the old one
+    // has faded out
     int oversamplingFactor = 1;
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+    Aetheri::OversamplingFilter oversamplingFilter = Aetheri::OversamplingFilter::MinimumLatencyIIR;
+    int resamplerLatency = 0;
+    float oversamplingFadeGain = 1.0f;
+    float oversamplingFadeStep = 1.0f;
+    
+    // Offline bounces have CPU to spare: while the host renders non-realtime the profile
+    // overrides the oversampling factor, eco precision and control rate, and reverts after
+    struct RenderProfile
+    {
+        int oversamplingFactor = 1 << maxOversamplingStages;
+        bool fullPrecision = true;  // 64-bit EQ and HPF/LPF even with eco precision on
+        int controlInterval = 1;    // Filter glides stepped every sample
+    };
+    
+    RenderProfile renderProfile;
+    bool renderProfileActive = false;
+    
+    // Picks the factor in Auto mode from the settings and the level reaching the saturation
+    Aetheri::OversamplingGovernor oversamplingGovernor;
+    
+    // Latency computed on the audio thread, reported to the host from the message thread
+    std::atomic<int> pendingLatency { 0 };
+    
+    // The audio thread never posts messages (that can block or allocate); it raises flags
+    // that a message-thread timer polls at this rate
+    static constexpr int messageThreadPollHz = 50;
+    
+    // EQ band and HPF/LPF designs are made on the message thread from the parameters and
+    // handed over as snapshots; the audio thread only glides towards the newest one.
+    // Offline renders design on the audio thread so every bounce comes out the same
+    juce::SharedResourcePointer<Aetheri::BiquadCoefficientCache> coefficientCache;
+    Aetheri::CoefficientSnapshotBuffer coefficientSnapshots;
+    std::atomic<juce::uint32> coefficientGeneration { 0 };
+    juce::uint32 appliedCoefficientGeneration = 0;  // Audio thread only
+    std::atomic<bool> coefficientDesignPending { false };
+    std::atomic<double> designSampleRate { 44100.0 };
     
     // Auto-gain compensation
     float referenceLevel = 0.0f;  // Reference level for auto-gain
     juce::SmoothedValue<float> autoGainAdjustment;
     
-    // Phase correlation
-    float phaseCorrelation = 0.0f;
-    
     void updateDSPFromParameters();
-    void calculatePhaseCorrelation(const juce::AudioBuffer<float>& buffer);
+    int calculateTotalLatency() const;
+    void updateTailLength();
+    bool isOversamplingChangeRequested() const;
+    void updateReportedLatency();
+    void requestLatencyUpdate();
+    void timerCallback() override;
+    Aetheri::EQBand::CurveType getBandCurve(int band, int channel) const;
+    Aetheri::CoefficientTargets getCoefficientTargets() const;
+    Aetheri::CoefficientSnapshot designCoefficientSnapshot();
+    void applyCoefficientSnapshot(const Aetheri::CoefficientSnapshot& snapshot, bool snap);
+    void requestCoefficientDesign();
+    int getRequestedOversamplingFactor() const;
+    Aetheri::OversamplingFilter getRequestedOversamplingFilter() const;
+    Aetheri::OversamplingGovernor::Settings getGovernorSettings() const;
+    bool isRenderProfileRequested() const;
+    void setRenderProfileActive(bool shouldBeActive);
+    Aetheri::PassiveEQ::Engine getChosenEQEngine() const;
+    void updateEngine();
+    
+    template <typename SampleType>
+    void prepareState(PrecisionState<SampleType>& state);
+    
+    template <typename SampleType>
+    void processBlockImpl(juce::AudioBuffer<SampleType>& buffer);
+    
+    template <typename SampleType>
+    void processSubBlock(juce::AudioBuffer<SampleType>& buffer);
+    
+    template <typename SampleType>
+    void setActiveOversampling(PrecisionState<SampleType>& state, int factor, Aetheri::OversamplingFilter design);
+    
+    template <typename SampleType>
+    void switchOversampling(PrecisionState<SampleType>& state, int factor, Aetheri::OversamplingFilter design);
+    
+    template <typename SampleType>
+    void applyOversamplingFade(const juce::dsp::AudioBlock<SampleType>& block, bool fadingOut);
+    
+    template <typename SampleType>
+    void primeOversampler(PrecisionState<SampleType>& state);
+    
+    template <typename SampleType>
+    static bool isSilent(const juce::AudioBuffer<SampleType>& buffer);
+    
     float calculateAutoGainAdjustment();
     
     // A/B Comparison methods (private helpers)
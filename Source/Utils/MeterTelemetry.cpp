@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    MeterTelemetry Implementation
+  ==============================================================================
+*/
+
+#include "MeterTelemetry.h"
+#include <cstring>
+
+namespace Aetheri
+{
+    void MeterTelemetry::publish(const MeterSnapshot& snapshot)
+    {
+        std::array<juce::uint64, numWords> payload;
+        std::memcpy(payload.data(), &snapshot, sizeof(snapshot));
+
+        // Odd while writing; the fence keeps the payload stores after the odd count
+        const auto start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < numWords; ++i)
+            words[i].store(payload[i], std::memory_order_relaxed);
+
+        sequence.store(start + 2, std::memory_order_release);
+    }
+
+    MeterSnapshot MeterTelemetry::read() const
+    {
+        std::array<juce::uint64, numWords> payload;
+
+        for (;;)
+        {
+            const auto before = sequence.load(std::memory_order_acquire);
+
+            if ((before & 1) != 0)
+                continue;  // Mid-write; the writer finishes within a few stores
+
+            for (size_t i = 0; i < numWords; ++i)
+                payload[i] = words[i].load(std::memory_order_relaxed);
+
+            // The payload loads complete before the counter is checked again
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence.load(std::memory_order_relaxed) == before)
+                break;
+        }
+
+        MeterSnapshot snapshot;
+        std::memcpy(static_cast<void*>(&snapshot), payload.data(), sizeof(snapshot));
+        return snapshot;
+    }
+}
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    MeterTelemetry - Per-Block Meter Readings from the Audio Thread
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+namespace Aetheri
+{
+    // Everything the editor's meters show, taken together at the end of one host block
+    struct MeterSnapshot
+    {
+        // Normalised 0-1 in each meter's own mode, left then right
+        std::array<float, 2> inputLevel {};
+        std::array<float, 2> inputPeak {};
+        std::array<float, 2> outputLevel {};
+        std::array<float, 2> outputPeak {};
+
+        float phaseCorrelation = 0.0f;
+        float glowIntensity = 0.0f;  // Hysteresis drive, 0-1
+    };
+
+    /**
+     * Single-writer sequence lock carrying one MeterSnapshot to any number of readers
+     * The audio thread publishes once per block; the counter is odd while a write is in
+     * progress, and a reader that saw it odd or saw it change retries, so every snapshot
+     * comes from a single block. The writer never waits. Counter and payload fill one
+     * cache line of their own, away from the DSP state the audio thread is working on
+     */
+    class alignas(64) MeterTelemetry
+    {
+    public:
+        MeterTelemetry() = default;
+
+        // Audio thread only
+        void publish(const MeterSnapshot& snapshot);
+
+        // Any thread
+        MeterSnapshot read() const;
+
+    private:
+        static_assert(std::is_trivially_copyable<MeterSnapshot>::value);
+        static_assert(sizeof(MeterSnapshot) % sizeof(juce::uint64) == 0);
+        static constexpr size_t numWords = sizeof(MeterSnapshot) / sizeof(juce::uint64);
+
+        std::atomic<juce::uint32> sequence { 0 };
+        std::array<std::atomic<juce::uint64>, numWords> words {};
+
+        JUCE_DECLARE_NON_COPYABLE(MeterTelemetry)
+    };
+
+    static_assert(sizeof(MeterTelemetry) == 64, "MeterTelemetry should fill exactly one cache line");
+}
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    Parameter Change Tracking Implementation
+  ==============================================================================
+*/
+
+#include "ParameterChangeTracker.h"
+
+namespace Aetheri
+{
+    bool ParameterChangeTracker::Changes::any() const
+    {
+        for (auto word : words)
+            if (word != 0)
+                return true;
+
+        return false;
+    }
+
+    ParameterChangeTracker::ParameterChangeTracker(juce::AudioProcessorValueTreeState& state)
+        : parameters(state)
+    {
+    }
+
+    ParameterChangeTracker::~ParameterChangeTracker()
+    {
+        for (size_t i = 0; i < listeners.size(); ++i)
+            parameters.removeParameterListener(trackedIDs[i], listeners[i].get());
+    }
+
+    int ParameterChangeTracker::track(const juce::String& parameterID)
+    {
+        const int index = static_cast<int>(listeners.size());
+        jassert(index < maxParameters);
+        jassert(parameters.getParameter(parameterID) != nullptr);
+
+        listeners.push_back(std::make_unique<Listener>(*this, index));
+        trackedIDs.push_back(parameterID);
+        parameters.addParameterListener(parameterID, listeners.back().get());
+
+        // A parameter starts out dirty so the first update applies it
+        setValue(index, parameters.getRawParameterValue(parameterID)->load());
+        return index;
+    }
+
+    void ParameterChangeTracker::markAllDirty()
+    {
+        for (int index = 0; index < static_cast<int>(listeners.size()); ++index)
+            markDirty(index);
+    }
+
+    void ParameterChangeTracker::setValue(int index, float newValue)
+    {
+        // Stored before the flag is raised, so the block that takes the flag reads the new value
+        values[static_cast<size_t>(index)].store(newValue, std::memory_order_relaxed);
+        markDirty(index);
+    }
+
+    void ParameterChangeTracker::markDirty(int index)
+    {
+        // Flag first, then publish: a collect() that sees the new version also sees the flag
+        dirty[static_cast<size_t>(index >> 6)].fetch_or(juce::uint64 { 1 } << (index & 63), std::memory_order_release);
+        version.fetch_add(1, std::memory_order_release);
+    }
+
+    bool ParameterChangeTracker::collect(Changes& changes)
+    {
+        const auto current = version.load(std::memory_order_acquire);
+
+        if (current == collectedVersion)
+            return false;
+
+        // A flag raised after this point bumps the version again and is picked up next block
+        collectedVersion = current;
+
+        for (size_t word = 0; word < dirty.size(); ++word)
+            changes.words[word] = dirty[word].exchange(0, std::memory_order_acq_rel);
+
+        return changes.any();
+    }
+}
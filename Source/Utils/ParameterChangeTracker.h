@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    Parameter Change Tracking for the Audio Thread
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Aetheri
+{
+    /**
+     * Dirty flags and a flat value cache for the parameter tree
+     * A listener per tracked parameter stores its new value, sets its bit and bumps a
+     * version counter from whichever thread changed it (host automation, the editor or a
+     * state restore). The audio thread checks the version once per block and only then
+     * takes the flags, so an idle block costs one atomic load instead of reloading every
+     * parameter; values are read by index from one contiguous array
+     */
+    class ParameterChangeTracker
+    {
+    public:
+        static constexpr int maxParameters = 128;
+        static constexpr int numWords = maxParameters / 64;
+
+        // Flags taken by one collect() call
+        struct Changes
+        {
+            std::array<juce::uint64, numWords> words {};
+
+            bool test(int index) const { return (words[static_cast<size_t>(index >> 6)] >> (index & 63)) & 1; }
+            bool any() const;
+        };
+
+        explicit ParameterChangeTracker(juce::AudioProcessorValueTreeState& state);
+        ~ParameterChangeTracker();
+
+        // Message thread, before processing starts: listens to a parameter and returns its index
+        int track(const juce::String& parameterID);
+        
+        // Any thread: the latest plain value of a tracked parameter
+        float getValue(int index) const { return values[static_cast<size_t>(index)].load(std::memory_order_relaxed); }
+
+        // Flags every tracked parameter, e.g. so prepareToPlay() applies them all
+        void markAllDirty();
+
+        // Audio thread: the flags raised since the last call, or false if nothing changed
+        bool collect(Changes& changes);
+
+    private:
+        struct Listener : juce::AudioProcessorValueTreeState::Listener
+        {
+            Listener(ParameterChangeTracker& t, int i) : tracker(t), index(i) {}
+            void parameterChanged(const juce::String&, float newValue) override { tracker.setValue(index, newValue); }
+
+            ParameterChangeTracker& tracker;
+            const int index;
+        };
+
+        juce::AudioProcessorValueTreeState& parameters;
+        std::vector<std::unique_ptr<Listener>> listeners;
+        std::vector<juce::String> trackedIDs;
+
+        std::array<std::atomic<float>, maxParameters> values {};
+        std::array<std::atomic<juce::uint64>, numWords> dirty {};
+        std::atomic<juce::uint32> version { 0 };
+        juce::uint32 collectedVersion = 0;  // Audio thread only
+
+        void setValue(int index, float newValue);
+        void markDirty(int index);
+
+        JUCE_DECLARE_NON_COPYABLE(ParameterChangeTracker)
+    };
+}
@@ -8,49 +8,11 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_core/juce_core.h>
+#include <array>
 
 // Core parameter namespace
 namespace Aetheri
 {
-    // Parameter IDs
-    namespace ParamIDs
-    {
-        // Input/Output Stage
-        inline const juce::String inputGain     { "inputGain" };
-        inline const juce::String outputTrim    { "outputTrim" };
-        
-        // Global Controls
-        inline const juce::String stereoMode    { "stereoMode" };      // 0 = L/R, 1 = M/S
-        inline const juce::String channelLink   { "channelLink" };     // Link both channels
-        
-        // High/Low Pass Filters
-        inline const juce::String hpfEnabled    { "hpfEnabled" };
-        inline const juce::String hpfFreq       { "hpfFreq" };
-        inline const juce::String lpfEnabled    { "lpfEnabled" };
-        inline const juce::String lpfFreq       { "lpfFreq" };
-        
-        // EQ Band Parameters - using format: band{0-3}_{param}_{channel}
-        // Channels: L=0, R=1 (or M=0, S=1 in M/S mode)
-        inline juce::String bandGain(int band, int channel)     { return "band" + juce::String(band) + "_gain_" + juce::String(channel); }
-        inline juce::String bandTrim(int band, int channel)     { return "band" + juce::String(band) + "_trim_" + juce::String(channel); }
-        inline juce::String bandFreq(int band, int channel)     { return "band" + juce::String(band) + "_freq_" + juce::String(channel); }
-        inline juce::String bandCurve(int band, int channel)    { return "band" + juce::String(band) + "_curve_" + juce::String(channel); }  // 0=Bell, 1=Shelf
-        inline juce::String bandEnabled(int band, int channel)  { return "band" + juce::String(band) + "_enabled_" + juce::String(channel); }
-        inline juce::String bandSolo(int band, int channel)     { return "band" + juce::String(band) + "_solo_" + juce::String(channel); }
-        inline juce::String bandMute(int band, int channel)    { return "band" + juce::String(band) + "_mute_" + juce::String(channel); }
-        
-        // Hysteresis Stage
-        inline const juce::String hystEnabled       { "hystEnabled" };
-        inline const juce::String tubeHarmonics     { "tubeHarmonics" };
-        inline const juce::String transformerSat    { "transformerSat" };
-        inline const juce::String hystMix           { "hystMix" };
-        
-        // Processing Options
-        inline const juce::String oversampling      { "oversampling" };  // 0=1x, 1=2x, 2=4x
-        inline const juce::String autoGainComp      { "autoGainComp" };  // Auto-gain compensation
-        inline const juce::String bypass            { "bypass" };        // Plugin bypass
-    }
-    
     // Band frequency defaults (Hz)
     namespace BandDefaults
     {
@@ -65,7 +27,7 @@ namespace Aetheri
         constexpr float hmfQ = 0.9f;   // Slightly narrower for presence
         constexpr float hfQ  = 0.7f;   // Broad for air
         
-        inline float getDefaultFreq(int band)
+        constexpr float getDefaultFreq(int band)
         {
             switch (band)
             {
@@ -77,7 +39,7 @@ namespace Aetheri
             }
         }
         
-        inline float getQ(int band)
+        constexpr float getQ(int band)
         {
             switch (band)
             {
@@ -113,7 +75,7 @@ namespace Aetheri
         constexpr float hpfMin = 20.0f,  hpfMax = 500.0f;
         constexpr float lpfMin = 2000.0f, lpfMax = 20000.0f;
         
-        inline float getMinFreq(int band)
+        constexpr float getMinFreq(int band)
         {
             switch (band)
             {
@@ -125,7 +87,7 @@ namespace Aetheri
             }
         }
         
-        inline float getMaxFreq(int band)
+        constexpr float getMaxFreq(int band)
         {
             switch (band)
             {
@@ -138,6 +100,318 @@ namespace Aetheri
         }
     }
     
+    // Registry indices, in host parameter order
+    namespace ParamIndex
+    {
+        enum class BandField { Gain, Trim, Freq, Curve, Enabled, Solo, Mute };
+        
+        constexpr int numBands = 4;
+        constexpr int numChannels = 2;
+        
+        // Only LF and HF switch between Bell and Shelf
+        constexpr bool hasCurve(int band) { return band == 0 || band == 3; }
+        constexpr int fieldsPerChannel(int band) { return hasCurve(band) ? 7 : 6; }
+        
+        // Band parameters run band by band, channel by channel, in BandField order
+        constexpr int bandOffset(int band, int channel)
+        {
+            int offset = 0;
+            
+            for (int b = 0; b < band; ++b)
+                offset += numChannels * fieldsPerChannel(b);
+            
+            return offset + channel * fieldsPerChannel(band);
+        }
+        
+        constexpr int fieldOffset(BandField field, int band)
+        {
+            const int index = static_cast<int>(field);
+            return (!hasCurve(band) && field > BandField::Curve) ? index - 1 : index;
+        }
+        
+        enum : int
+        {
+            // Input/Output, global controls, HPF/LPF
+            inputGain = 0, outputTrim, stereoMode, channelLink,
+            hpfEnabled, hpfFreq, lpfEnabled, lpfFreq,
+            
+            firstBandParameter,
+            
+            // Hysteresis, processing options
+            hystEnabled = firstBandParameter + bandOffset(numBands, 0),
+            tubeHarmonics, transformerSat, hystMix,
+            oversampling, autoGainComp, bypass,
+            
+            // Added since v00.14 - appended, so the parameters above keep their host index
+            eqEngine, oversamplingAuto, highOversampling, linearPhase, ecoPrecision, renderQuality, oversamplingFilter,
+            
+            count
+        };
+        
+        // -1 for the curve of a band that has none
+        constexpr int bandParameter(BandField field, int band, int channel)
+        {
+            return (field == BandField::Curve && !hasCurve(band)) ? -1
+                 : firstBandParameter + bandOffset(band, channel) + fieldOffset(field, band);
+        }
+        
+        constexpr int bandGain(int band, int channel)     { return bandParameter(BandField::Gain, band, channel); }
+        constexpr int bandTrim(int band, int channel)     { return bandParameter(BandField::Trim, band, channel); }
+        constexpr int bandFreq(int band, int channel)     { return bandParameter(BandField::Freq, band, channel); }
+        constexpr int bandCurve(int band, int channel)    { return bandParameter(BandField::Curve, band, channel); }
+        constexpr int bandEnabled(int band, int channel)  { return bandParameter(BandField::Enabled, band, channel); }
+        constexpr int bandSolo(int band, int channel)     { return bandParameter(BandField::Solo, band, channel); }
+        constexpr int bandMute(int band, int channel)     { return bandParameter(BandField::Mute, band, channel); }
+    }
+    
+    /**
+     * One entry of the parameter registry
+     * Text is stored in fixed-size buffers so the whole table, band IDs and names
+     * included, is built at compile time
+     */
+    struct ParameterInfo
+    {
+        enum class Kind { Float, Bool, Choice };
+        
+        struct Text
+        {
+            static constexpr int capacity = 32;
+            char chars[capacity] {};
+            
+            constexpr Text() = default;
+            constexpr Text(const char* text) { append(text); }
+            
+            constexpr int length() const
+            {
+                int n = 0;
+                while (chars[n] != 0)
+                    ++n;
+                return n;
+            }
+            
+            constexpr Text& append(const char* text)
+            {
+                int n = length();
+                while (*text != 0 && n < capacity - 1)
+                    chars[n++] = *text++;
+                return *this;
+            }
+            
+            constexpr Text& append(int digit)
+            {
+                const char text[] = { static_cast<char>('0' + digit), 0 };
+                return append(text);
+            }
+        };
+        
+        Text id, name;
+        Kind kind = Kind::Float;
+        float minimum = 0.0f, maximum = 1.0f, interval = 0.0f, skew = 1.0f;
+        float defaultValue = 0.0f;   // Plain value (choice index, 0/1 for switches)
+        const char* label = "";      // Unit, or the choices separated by '|'
+        bool inPresets = true;       // Reset by presets; solo/mute and processing options are kept
+        int version = 1;             // Plugin version that added the parameter (host parameter ID hint)
+    };
+    
+    namespace ParameterTableDetail
+    {
+        constexpr ParameterInfo makeFloat(ParameterInfo::Text id, ParameterInfo::Text name, float minimum, float maximum,
+                                          float interval, float skew, float defaultValue, const char* label)
+        {
+            ParameterInfo info;
+            info.id = id;
+            info.name = name;
+            info.minimum = minimum;
+            info.maximum = maximum;
+            info.interval = interval;
+            info.skew = skew;
+            info.defaultValue = defaultValue;
+            info.label = label;
+            return info;
+        }
+        
+        constexpr ParameterInfo makeBool(ParameterInfo::Text id, ParameterInfo::Text name, bool defaultValue, bool inPresets = true)
+        {
+            ParameterInfo info;
+            info.id = id;
+            info.name = name;
+            info.kind = ParameterInfo::Kind::Bool;
+            info.defaultValue = defaultValue ? 1.0f : 0.0f;
+            info.inPresets = inPresets;
+            return info;
+        }
+        
+        constexpr ParameterInfo makeChoice(ParameterInfo::Text id, ParameterInfo::Text name, const char* choices,
+                                           int numChoices, int defaultIndex, bool inPresets = true)
+        {
+            ParameterInfo info;
+            info.id = id;
+            info.name = name;
+            info.kind = ParameterInfo::Kind::Choice;
+            info.maximum = static_cast<float>(numChoices - 1);
+            info.interval = 1.0f;
+            info.defaultValue = static_cast<float>(defaultIndex);
+            info.label = choices;
+            info.inPresets = inPresets;
+            return info;
+        }
+        
+        constexpr auto makeParameterTable()
+        {
+            using namespace ParamIndex;
+            using Text = ParameterInfo::Text;
+            
+            std::array<ParameterInfo, count> table {};
+            
+            // Input/Output Gain Stage
+            table[inputGain] = makeFloat("inputGain", "Input Gain", -12.0f, 12.0f, 0.1f, 1.0f, 0.0f, "dB");
+            table[outputTrim] = makeFloat("outputTrim", "Output Trim", -12.0f, 12.0f, 0.1f, 1.0f, 0.0f, "dB");
+            
+            // Global Controls
+            table[stereoMode] = makeChoice("stereoMode", "Stereo Mode", "L/R|M/S", 2, 0);  // 0 = L/R, 1 = M/S
+            table[channelLink] = makeBool("channelLink", "Channel Link", true);
+            
+            // High/Low Pass Filters
+            table[hpfEnabled] = makeBool("hpfEnabled", "HPF Enable", false);
+            table[hpfFreq] = makeFloat("hpfFreq", "HPF Frequency", FreqRanges::hpfMin, FreqRanges::hpfMax, 1.0f, 0.3f, 30.0f, "Hz");
+            table[lpfEnabled] = makeBool("lpfEnabled", "LPF Enable", false);
+            table[lpfFreq] = makeFloat("lpfFreq", "LPF Frequency", FreqRanges::lpfMin, FreqRanges::lpfMax, 1.0f, 0.3f, 18000.0f, "Hz");
+            
+            // EQ Bands - IDs band{0-3}_{param}_{channel}; channels L=0, R=1 (or M=0, S=1 in M/S mode)
+            const char* bandNames[] = { "LF", "LMF", "HMF", "HF" };
+            const char* channelNames[] = { " L", " R" };
+            
+            for (int band = 0; band < numBands; ++band)
+            {
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    auto bandID = [&](const char* field) { return Text("band").append(band).append(field).append(channel); };
+                    auto bandName = [&](const char* field) { return Text(bandNames[band]).append(field).append(channelNames[channel]); };
+                    
+                    table[bandGain(band, channel)] = makeFloat(bandID("_gain_"), bandName(" Gain"), -10.0f, 10.0f, 0.1f, 1.0f, 0.0f, "dB");  // Main Gain (±10dB)
+                    table[bandTrim(band, channel)] = makeFloat(bandID("_trim_"), bandName(" Trim"), -1.0f, 1.0f, 0.01f, 1.0f, 0.0f, "dB");  // Fine Trim (±1dB)
+                    table[bandFreq(band, channel)] = makeFloat(bandID("_freq_"), bandName(" Freq"), FreqRanges::getMinFreq(band),
+                                                               FreqRanges::getMaxFreq(band), 1.0f, 0.3f, BandDefaults::getDefaultFreq(band), "Hz");
+                    
+                    if (hasCurve(band))
+                        table[bandCurve(band, channel)] = makeChoice(bandID("_curve_"), bandName(" Curve"), "Bell|Shelf", 2, 0);  // 0=Bell, 1=Shelf
+                    
+                    table[bandEnabled(band, channel)] = makeBool(bandID("_enabled_"), bandName(" Enable"), true);
+                    table[bandSolo(band, channel)] = makeBool(bandID("_solo_"), bandName(" Solo"), false, false);
+                    table[bandMute(band, channel)] = makeBool(bandID("_mute_"), bandName(" Mute"), false, false);
+                }
+            }
+            
+            // Hysteresis Stage
+            table[hystEnabled] = makeBool("hystEnabled", "Hysteresis Enable", false);
+            table[tubeHarmonics] = makeFloat("tubeHarmonics", "Tube Harmonics", 0.0f, 100.0f, 0.1f, 1.0f, 0.0f, "%");
+            table[transformerSat] = makeFloat("transformerSat", "Transformer Saturate", 0.0f, 100.0f, 0.1f, 1.0f, 0.0f, "%");
+            table[hystMix] = makeFloat("hystMix", "Hysteresis Mix", 0.0f, 100.0f, 0.1f, 1.0f, 100.0f, "%");
+            
+            // Processing Options
+            table[oversampling] = makeChoice("oversampling", "Oversampling", "1x|2x|4x", 3, 0, false);
+            table[autoGainComp] = makeBool("autoGainComp", "Auto Gain Compensation", false, false);
+            table[bypass] = makeBool("bypass", "Bypass", false, false);
+            
+            // Minimum-phase EQ engine when neither linear phase nor eco precision is on
+            table[eqEngine] = makeChoice("eqEngine", "EQ Engine", "Serial|Parallel|Reference", 3, 0, false);  // 0=Serial cascade, 1=Parallel form, 2=Per-band reference
+            table[eqEngine].version = 2;
+            
+            // Governor-picked factor, overriding the oversampling choice; a switch of its own so
+            // the choice keeps its entries
+            table[oversamplingAuto] = makeBool("oversamplingAuto", "Auto Oversampling", false, false);
+            table[oversamplingAuto].version = 2;
+            
+            // 8x and 16x, overriding the 1x-4x choice. Appending them to that choice would have
+            // moved its normalised values, so saved automation would land on other factors
+            table[highOversampling] = makeChoice("highOversampling", "High Oversampling", "Off|8x|16x", 3, 0, false);
+            table[highOversampling].version = 2;
+            
+            // Linear-phase EQ (adds latency)
+            table[linearPhase] = makeBool("linearPhase", "Linear Phase", false, false);
+            table[linearPhase].version = 2;
+            
+            // 32-bit EQ and HPF/LPF
+            table[ecoPrecision] = makeBool("ecoPrecision", "Eco Precision", false, false);
+            table[ecoPrecision].version = 2;
+            
+            // Render profile while the host bounces offline
+            table[renderQuality] = makeBool("renderQuality", "Render Quality", true, false);
+            table[renderQuality].version = 2;
+            
+            // Resampler design for the saturation stage
+            table[oversamplingFilter] = makeChoice("oversamplingFilter", "Oversampling Filter", "IIR|FIR", 2, 0, false);  // 0=IIR (min latency), 1=FIR (linear phase)
+            table[oversamplingFilter].version = 2;
+            
+            return table;
+        }
+        
+        template <typename Table>
+        constexpr bool isComplete(const Table& table)
+        {
+            for (const auto& info : table)
+                if (info.id.chars[0] == 0)
+                    return false;
+            
+            return true;
+        }
+    }
+    
+    // Every parameter, in host order - the single source for the layout, IDs and preset reset
+    inline constexpr auto parameterTable = ParameterTableDetail::makeParameterTable();
+    static_assert(ParameterTableDetail::isComplete(parameterTable), "Every ParamIndex needs a registry entry");
+    
+    // Parameter IDs, taken from the registry
+    namespace ParamIDs
+    {
+        inline juce::String fromIndex(int index)
+        {
+            jassert(index >= 0 && index < ParamIndex::count);
+            return index >= 0 ? juce::String(parameterTable[static_cast<size_t>(index)].id.chars) : juce::String();
+        }
+        
+        // Input/Output Stage
+        inline const juce::String inputGain     { fromIndex(ParamIndex::inputGain) };
+        inline const juce::String outputTrim    { fromIndex(ParamIndex::outputTrim) };
+        
+        // Global Controls
+        inline const juce::String stereoMode    { fromIndex(ParamIndex::stereoMode) };      // 0 = L/R, 1 = M/S
+        inline const juce::String channelLink   { fromIndex(ParamIndex::channelLink) };     // Link both channels
+        
+        // High/Low Pass Filters
+        inline const juce::String hpfEnabled    { fromIndex(ParamIndex::hpfEnabled) };
+        inline const juce::String hpfFreq       { fromIndex(ParamIndex::hpfFreq) };
+        inline const juce::String lpfEnabled    { fromIndex(ParamIndex::lpfEnabled) };
+        inline const juce::String lpfFreq       { fromIndex(ParamIndex::lpfFreq) };
+        
+        // EQ Band Parameters
+        inline juce::String bandGain(int band, int channel)     { return fromIndex(ParamIndex::bandGain(band, channel)); }
+        inline juce::String bandTrim(int band, int channel)     { return fromIndex(ParamIndex::bandTrim(band, channel)); }
+        inline juce::String bandFreq(int band, int channel)     { return fromIndex(ParamIndex::bandFreq(band, channel)); }
+        inline juce::String bandCurve(int band, int channel)    { return fromIndex(ParamIndex::bandCurve(band, channel)); }  // 0=Bell, 1=Shelf
+        inline juce::String bandEnabled(int band, int channel)  { return fromIndex(ParamIndex::bandEnabled(band, channel)); }
+        inline juce::String bandSolo(int band, int channel)     { return fromIndex(ParamIndex::bandSolo(band, channel)); }
+        inline juce::String bandMute(int band, int channel)     { return fromIndex(ParamIndex::bandMute(band, channel)); }
+        
+        // Hysteresis Stage
+        inline const juce::String hystEnabled       { fromIndex(ParamIndex::hystEnabled) };
+        inline const juce::String tubeHarmonics     { fromIndex(ParamIndex::tubeHarmonics) };
+        inline const juce::String transformerSat    { fromIndex(ParamIndex::transformerSat) };
+        inline const juce::String hystMix           { fromIndex(ParamIndex::hystMix) };
+        
+        // Processing Options
+        inline const juce::String oversampling      { fromIndex(ParamIndex::oversampling) };  // 0=1x, 1=2x, 2=4x
+        inline const juce::String autoGainComp      { fromIndex(ParamIndex::autoGainComp) };  // Auto-gain compensation
+        inline const juce::String bypass            { fromIndex(ParamIndex::bypass) };        // Plugin bypass
+        inline const juce::String eqEngine          { fromIndex(ParamIndex::eqEngine) };      // 0=Serial, 1=Parallel, 2=Reference
+        inline const juce::String oversamplingAuto  { fromIndex(ParamIndex::oversamplingAuto) };  // Governor picks the factor
+        inline const juce::String highOversampling  { fromIndex(ParamIndex::highOversampling) };  // 0=Off, 1=8x, 2=16x
+        inline const juce::String linearPhase       { fromIndex(ParamIndex::linearPhase) };
+        inline const juce::String ecoPrecision      { fromIndex(ParamIndex::ecoPrecision) };
+        inline const juce::String renderQuality     { fromIndex(ParamIndex::renderQuality) };
+        inline const juce::String oversamplingFilter { fromIndex(ParamIndex::oversamplingFilter) };
+    }
+    
     // Create all parameters for the plugin
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 }
@@ -15,35 +15,14 @@ namespace Aetheri
     // Helper function to reset all parameters to defaults
     static void resetAllParameters(juce::AudioProcessorValueTreeState& apvts)
     {
-        auto resetParam = [&apvts](const juce::String& id) {
-            if (auto* param = apvts.getParameter(id))
-                param->setValueNotifyingHost(param->getDefaultValue());
-        };
-        
-        resetParam(ParamIDs::inputGain);
-        resetParam(ParamIDs::outputTrim);
-        resetParam(ParamIDs::stereoMode);
-        resetParam(ParamIDs::channelLink);
-        resetParam(ParamIDs::hpfEnabled);
-        resetParam(ParamIDs::hpfFreq);
-        resetParam(ParamIDs::lpfEnabled);
-        resetParam(ParamIDs::lpfFreq);
-        resetParam(ParamIDs::hystEnabled);
-        resetParam(ParamIDs::tubeHarmonics);
-        resetParam(ParamIDs::transformerSat);
-        resetParam(ParamIDs::hystMix);
-        
-        for (int band = 0; band < 4; ++band)
+        // Everything a preset covers; solo/mute and the processing options are left alone
+        for (const auto& info : parameterTable)
         {
-            for (int ch = 0; ch < 2; ++ch)
-            {
-                resetParam(ParamIDs::bandGain(band, ch));
-                resetParam(ParamIDs::bandTrim(band, ch));
-                resetParam(ParamIDs::bandFreq(band, ch));
-                resetParam(ParamIDs::bandEnabled(band, ch));
-                if (band == 0 || band == 3)
-                    resetParam(ParamIDs::bandCurve(band, ch));
-            }
+            if (!info.inPresets)
+                continue;
+            
+            if (auto* param = apvts.getParameter(info.id.chars))
+                param->setValueNotifyingHost(param->getDefaultValue());
         }
     }
     
@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    ChannelEQTests - Mask-Specialised Reference Kernels
+  ==============================================================================
+*/
+
+#include "TestUtilities.h"
+
+namespace Aetheri
+{
+    namespace
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 64;
+
+        struct BandFlags
+        {
+            std::array<bool, ChannelEQ::NumBands> enabled {}, solo {}, mute {};
+        };
+
+        // The original per-sample rule, kept here as the specification
+        bool isBandAudible(const BandFlags& flags, int band)
+        {
+            bool anySolo = false;
+
+            for (bool solo : flags.solo)
+                anySolo = anySolo || solo;
+
+            const auto b = static_cast<size_t>(band);
+            return flags.enabled[b] && !(anySolo && !flags.solo[b]) && !(flags.mute[b] && !flags.solo[b]);
+        }
+
+        BandFlags makeRandomFlags(juce::Random& random)
+        {
+            BandFlags flags;
+
+            for (size_t band = 0; band < flags.enabled.size(); ++band)
+            {
+                flags.enabled[band] = random.nextInt(4) != 0;
+                flags.solo[band] = random.nextInt(5) == 0;
+                flags.mute[band] = random.nextInt(5) == 0;
+            }
+
+            return flags;
+        }
+
+        BandFlags makeMaskFlags(int mask)
+        {
+            BandFlags flags;
+
+            for (size_t band = 0; band < flags.enabled.size(); ++band)
+                flags.enabled[band] = (mask & (1 << band)) != 0;
+
+            return flags;
+        }
+
+        void setUpChannel(ChannelEQ& eq, const Tests::EQSettings& settings, const CoefficientSnapshot& snapshot,
+                          const BandFlags& flags)
+        {
+            eq.prepare(sampleRate, blockSize);
+
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+            {
+                const auto b = static_cast<size_t>(band);
+                const auto& s = settings[b];
+                eq.setBandParameters(band, s.frequency, s.gainDB, 0.0f, s.curve, flags.enabled[b]);
+                eq.setBandSolo(band, flags.solo[b]);
+                eq.setBandMute(band, flags.mute[b]);
+                eq.setBandTarget(band, snapshot.bands[0][b], snapshot.bandShapes[0][b], true);
+            }
+        }
+
+        // Four separate bands with the solo/mute/enable decision made per band per sample,
+        // the way the reference engine ran before it was specialised
+        struct RuntimeCheckedChannel
+        {
+            std::array<EQBand, ChannelEQ::NumBands> bands;
+            BandFlags flags;
+
+            void setUp(const Tests::EQSettings& settings, const CoefficientSnapshot& snapshot, const BandFlags& newFlags)
+            {
+                flags = newFlags;
+
+                for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                {
+                    const auto b = static_cast<size_t>(band);
+                    const auto& s = settings[b];
+                    bands[b].prepare(sampleRate, blockSize);
+                    bands[b].setParameters(s.frequency, s.gainDB, BandDefaults::getQ(band), s.curve, flags.enabled[b]);
+                    bands[b].setTargetCoefficients(snapshot.bands[0][b], snapshot.bandShapes[0][b], true);
+                }
+            }
+
+            template <typename SampleType>
+            void processBlock(SampleType* data, int numSamples)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    SampleType output = data[i];
+
+                    for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                        if (isBandAudible(flags, band))
+                            output = bands[static_cast<size_t>(band)].processActiveSample(output);
+
+                    data[i] = output;
+                }
+            }
+        };
+    }
+
+    class ChannelEQTests : public juce::UnitTest
+    {
+    public:
+        ChannelEQTests() : juce::UnitTest("ChannelEQ", Tests::testCategory) {}
+
+        void runTest() override
+        {
+            juce::Random random(Tests::randomSeed);
+
+            beginTest("Masked kernels match the per-sample band checks");
+            {
+                constexpr int numSamples = 4096;
+
+                for (int trial = 0; trial < 64; ++trial)
+                {
+                    // Every enable mask once, then random solo/mute combinations
+                    const auto flags = trial < 16 ? makeMaskFlags(trial) : makeRandomFlags(random);
+                    const auto settings = Tests::makeRandomEQ(random);
+                    const auto snapshot = Tests::makeSnapshot(sampleRate, settings, settings);
+
+                    ChannelEQ masked;
+                    RuntimeCheckedChannel checked;
+                    setUpChannel(masked, settings, snapshot, flags);
+                    checked.setUp(settings, snapshot, flags);
+
+                    juce::AudioBuffer<double> maskedOut(1, numSamples), checkedOut(1, numSamples);
+                    Tests::fillWithNoise(maskedOut, random);
+                    checkedOut.makeCopyOf(maskedOut);
+
+                    for (int start = 0; start < numSamples; start += blockSize)
+                    {
+                        masked.processBlock(maskedOut.getWritePointer(0) + start, blockSize);
+                        checked.processBlock(checkedOut.getWritePointer(0) + start, blockSize);
+                    }
+
+                    int expectedMask = 0;
+
+                    for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                    {
+                        expectEquals(masked.isBandActive(band), isBandAudible(flags, band), "Band " + juce::String(band) + " activity");
+                        expectedMask |= isBandAudible(flags, band) ? 1 << band : 0;
+                    }
+
+                    // Same operations in the same order, so the output is bit-identical
+                    expectEquals(Tests::maxAbsDifference(maskedOut, checkedOut), 0.0,
+                                 "Output for active-band mask " + juce::String(expectedMask));
+                }
+            }
+
+            beginTest("Reference engine matches the vectorised engine");
+            {
+                constexpr int numSamples = 16384;
+                constexpr float tolerance = 1.0e-5f;
+
+                const auto left = Tests::makeRandomEQ(random);
+                const auto right = Tests::makeRandomEQ(random);
+
+                PassiveEQ reference, vectorised;
+                Tests::setUpEQ(reference, PassiveEQ::Engine::Reference, sampleRate, blockSize, left, right);
+                Tests::setUpEQ(vectorised, PassiveEQ::Engine::Vectorised, sampleRate, blockSize, left, right);
+
+                juce::AudioBuffer<float> referenceOut(2, numSamples), vectorisedOut(2, numSamples);
+                Tests::fillWithNoise(referenceOut, random);
+                vectorisedOut.makeCopyOf(referenceOut);
+
+                Tests::processInBlocks(reference, referenceOut, blockSize);
+                Tests::processInBlocks(vectorised, vectorisedOut, blockSize);
+
+                expectLessThan(Tests::maxAbsDifference(referenceOut, vectorisedOut), tolerance, "Engines agree");
+            }
+        }
+    };
+
+    class ChannelEQBenchmarks : public juce::UnitTest
+    {
+    public:
+        ChannelEQBenchmarks() : juce::UnitTest("ChannelEQ masks", Tests::benchmarkCategory) {}
+
+        void runTest() override
+        {
+            beginTest("Mask-specialised kernels against per-sample band checks");
+
+            juce::Random random(Tests::randomSeed);
+            constexpr int numBlocks = 2048;
+            constexpr int runs = 7;
+
+            const auto settings = Tests::makeRandomEQ(random);
+            const auto snapshot = Tests::makeSnapshot(sampleRate, settings, settings);
+
+            juce::AudioBuffer<float> input(1, blockSize), work(1, blockSize);
+            Tests::fillWithNoise(input, random);
+
+            logMessage("mask | runtime checks ns/sample | masked ns/sample | speed-up");
+
+            for (int mask = 0; mask < 16; ++mask)
+            {
+                const auto flags = makeMaskFlags(mask);
+
+                ChannelEQ masked;
+                RuntimeCheckedChannel checked;
+                setUpChannel(masked, settings, snapshot, flags);
+                checked.setUp(settings, snapshot, flags);
+
+                auto run = [&] (auto& eq)
+                {
+                    for (int block = 0; block < numBlocks; ++block)
+                    {
+                        work.copyFrom(0, 0, input, 0, 0, blockSize);
+                        eq.processBlock(work.getWritePointer(0), blockSize);
+                    }
+                };
+
+                const double perSample = 1.0 / (numBlocks * static_cast<double>(blockSize));
+                const double checkedNs = Tests::timeBestOf(runs, [&] { run(checked); }) * perSample;
+                const double maskedNs = Tests::timeBestOf(runs, [&] { run(masked); }) * perSample;
+
+                logMessage(juce::String(mask).paddedLeft(' ', 4) + " | " + juce::String(checkedNs, 2) + " | "
+                           + juce::String(maskedNs, 2) + " | " + juce::String(checkedNs / maskedNs, 2) + "x");
+            }
+        }
+    };
+
+    static ChannelEQTests channelEQTests;
+    static ChannelEQBenchmarks channelEQBenchmarks;
+}
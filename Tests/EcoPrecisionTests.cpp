@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    EcoPrecisionTests - 32-bit SVF Engines Against the 64-bit Reference
+  ==============================================================================
+*/
+
+#include "TestUtilities.h"
+#include "HighLowPassFilters.h"
+
+namespace Aetheri
+{
+    namespace
+    {
+        // Error energy relative to the reference signal, in dB
+        double getRelativeErrorDB(const juce::AudioBuffer<double>& reference, const juce::AudioBuffer<double>& test,
+                                  int startSample = 0)
+        {
+            double signal = 0.0, error = 0.0;
+
+            for (int ch = 0; ch < reference.getNumChannels(); ++ch)
+            {
+                for (int i = startSample; i < reference.getNumSamples(); ++i)
+                {
+                    const double r = reference.getSample(ch, i);
+                    const double d = test.getSample(ch, i) - r;
+                    signal += r * r;
+                    error += d * d;
+                }
+            }
+
+            return 10.0 * std::log10(std::max(error, 1.0e-300) / std::max(signal, 1.0e-300));
+        }
+
+        // Low shelf on the LF band, the other bands moderate
+        Tests::EQSettings makeLowShelfEQ(float frequency, float gainDB)
+        {
+            Tests::EQSettings settings;
+            settings[0] = { EQBand::CurveType::Shelf, frequency, gainDB };
+            settings[1] = { EQBand::CurveType::Bell, 250.0f, -3.0f };
+            settings[2] = { EQBand::CurveType::Bell, 3000.0f, 2.0f };
+            settings[3] = { EQBand::CurveType::Bell, 10000.0f, 1.5f };
+            return settings;
+        }
+
+        void setUpFilters(FilterSection& filters, double sampleRate, float highPassHz, float lowPassHz, bool eco)
+        {
+            filters.setHPFEnabled(true);
+            filters.setLPFEnabled(true);
+            filters.setHPFFrequency(highPassHz);
+            filters.setLPFFrequency(lowPassHz);
+            filters.prepare(sampleRate, 64);
+            filters.setTargetCoefficients(HighPassFilter::designCoefficients(highPassHz, sampleRate),
+                                          LowPassFilter::designCoefficients(lowPassHz, sampleRate), true);
+            filters.setEcoPrecision(eco);
+        }
+
+        void processFilters(FilterSection& filters, juce::AudioBuffer<double>& buffer, int startSample, int numSamples, int blockSize)
+        {
+            for (int start = startSample; start < startSample + numSamples; start += blockSize)
+            {
+                const int length = std::min(blockSize, startSample + numSamples - start);
+                juce::dsp::AudioBlock<double> block(buffer.getArrayOfWritePointers(), 2,
+                                                    static_cast<size_t>(start), static_cast<size_t>(length));
+                filters.processBlock(block);
+            }
+        }
+
+        // Brown-ish noise: most of its energy where the low shelves and high-pass act
+        void fillWithLowNoise(juce::AudioBuffer<double>& buffer, juce::Random& random)
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                double lowPassed = 0.0;
+
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                {
+                    lowPassed += 0.002 * ((random.nextDouble() * 2.0 - 1.0) - lowPassed);
+                    buffer.setSample(ch, i, 20.0 * lowPassed + 0.05 * (random.nextDouble() * 2.0 - 1.0));
+                }
+            }
+        }
+    }
+
+    class EcoPrecisionTests : public juce::UnitTest
+    {
+    public:
+        EcoPrecisionTests() : juce::UnitTest("Eco precision", Tests::testCategory) {}
+
+        void runTest() override
+        {
+            juce::Random random(Tests::randomSeed);
+
+            // Error energy against the 64-bit engines on low-heavy noise; the eco engines keep
+            // their state in float, where a 32-bit direct-form biquad only manages about
+            // -45 dB on the lowest shelves at 192 kHz
+            constexpr double accuracyToleranceDB = -95.0;
+            // Handing state between forms adds no more than the eco engines' own error;
+            // restarting from silence instead would leave a transient near 0 dB
+            constexpr double handoverToleranceDB = -95.0;
+            constexpr int blockSize = 64;
+
+            beginTest("Low shelves stay within tolerance of the 64-bit engine");
+            {
+                double worst = -400.0;
+
+                for (double sampleRate : { 96000.0, 192000.0 })
+                {
+                    for (float frequency : { 20.0f, 40.0f, 80.0f })
+                    {
+                        for (float gainDB : { -12.0f, 12.0f })
+                        {
+                            const auto settings = makeLowShelfEQ(frequency, gainDB);
+                            const int numSamples = static_cast<int>(sampleRate);
+
+                            PassiveEQ reference, eco;
+                            Tests::setUpEQ(reference, PassiveEQ::Engine::Vectorised, sampleRate, blockSize, settings, settings);
+                            Tests::setUpEQ(eco, PassiveEQ::Engine::Eco, sampleRate, blockSize, settings, settings);
+
+                            juce::AudioBuffer<double> referenceOut(2, numSamples), ecoOut(2, numSamples);
+                            fillWithLowNoise(referenceOut, random);
+                            ecoOut.makeCopyOf(referenceOut);
+
+                            Tests::processInBlocks(reference, referenceOut, blockSize);
+                            Tests::processInBlocks(eco, ecoOut, blockSize);
+
+                            const double errorDB = getRelativeErrorDB(referenceOut, ecoOut);
+                            worst = std::max(worst, errorDB);
+                            expectLessThan(errorDB, accuracyToleranceDB, juce::String(frequency) + " Hz shelf, "
+                                           + juce::String(gainDB) + " dB at " + juce::String(sampleRate) + " Hz");
+                        }
+                    }
+                }
+
+                logMessage("Worst EQ error " + juce::String(worst, 1) + " dB");
+            }
+
+            beginTest("Low high-pass and low-pass filters stay within tolerance of the 64-bit filters");
+            {
+                double worst = -400.0;
+
+                for (double sampleRate : { 96000.0, 192000.0 })
+                {
+                    for (float highPassHz : { 20.0f, 40.0f, 80.0f })
+                    {
+                        const int numSamples = static_cast<int>(sampleRate);
+
+                        FilterSection reference, eco;
+                        setUpFilters(reference, sampleRate, highPassHz, 2000.0f, false);
+                        setUpFilters(eco, sampleRate, highPassHz, 2000.0f, true);
+
+                        juce::AudioBuffer<double> referenceOut(2, numSamples), ecoOut(2, numSamples);
+                        fillWithLowNoise(referenceOut, random);
+                        ecoOut.makeCopyOf(referenceOut);
+
+                        processFilters(reference, referenceOut, 0, numSamples, blockSize);
+                        processFilters(eco, ecoOut, 0, numSamples, blockSize);
+
+                        const double errorDB = getRelativeErrorDB(referenceOut, ecoOut);
+                        worst = std::max(worst, errorDB);
+                        expectLessThan(errorDB, accuracyToleranceDB, juce::String(highPassHz) + " Hz high-pass at "
+                                       + juce::String(sampleRate) + " Hz");
+                    }
+                }
+
+                logMessage("Worst filter error " + juce::String(worst, 1) + " dB");
+            }
+
+            beginTest("Eco output doesn't depend on the block size");
+            {
+                // Short blocks run mostly in the pipeline's fill and drain steps, long ones in
+                // the SIMD loop; the two differ only in rounding
+                constexpr double sampleRate = 48000.0;
+                constexpr int numSamples = 4096;
+                constexpr float tolerance = 1.0e-6f;
+                float worst = 0.0f;
+
+                for (int numLive = 1; numLive <= ChannelEQ::NumBands; ++numLive)
+                {
+                    auto settings = Tests::makeRandomEQ(random);
+
+                    // Flat bands are bypassed, leaving numLive sections in the kernel
+                    for (int band = numLive; band < ChannelEQ::NumBands; ++band)
+                        settings[static_cast<size_t>(band)].gainDB = 0.0f;
+
+                    juce::AudioBuffer<float> input(2, numSamples);
+                    Tests::fillWithNoise(input, random);
+
+                    juce::AudioBuffer<float> expected;
+                    expected.makeCopyOf(input);
+                    PassiveEQ reference;
+                    Tests::setUpEQ(reference, PassiveEQ::Engine::Eco, sampleRate, blockSize, settings, settings);
+                    Tests::processInBlocks(reference, expected, blockSize);
+
+                    for (int length : { 1, 2, 3, 5, 17, 256 })
+                    {
+                        juce::AudioBuffer<float> output;
+                        output.makeCopyOf(input);
+                        PassiveEQ eco;
+                        Tests::setUpEQ(eco, PassiveEQ::Engine::Eco, sampleRate, blockSize, settings, settings);
+                        Tests::processInBlocks(eco, output, length);
+                        worst = std::max(worst, Tests::maxAbsDifference(expected, output));
+                    }
+                }
+
+                logMessage("Worst difference across block sizes " + juce::String(worst, 9));
+                expectLessThan(worst, tolerance, "Block sizes agree");
+            }
+
+            beginTest("Switching the EQ engine mid-stream hands the state over");
+            {
+                constexpr double sampleRate = 192000.0;
+                constexpr int numSamples = 96000;
+                constexpr int switchAt = numSamples / 3;
+                constexpr int switchBackAt = 2 * numSamples / 3;
+
+                const auto settings = makeLowShelfEQ(30.0f, 12.0f);
+
+                for (auto engine : { PassiveEQ::Engine::Vectorised, PassiveEQ::Engine::Reference, PassiveEQ::Engine::Parallel })
+                {
+                    PassiveEQ steady, switched;
+                    Tests::setUpEQ(steady, engine, sampleRate, blockSize, settings, settings);
+                    Tests::setUpEQ(switched, engine, sampleRate, blockSize, settings, settings);
+
+                    juce::AudioBuffer<double> steadyOut(2, numSamples), switchedOut(2, numSamples);
+                    fillWithLowNoise(steadyOut, random);
+                    switchedOut.makeCopyOf(steadyOut);
+                    Tests::processInBlocks(steady, steadyOut, blockSize);
+
+                    // Eco for the middle third, then back
+                    for (int start = 0; start < numSamples; start += blockSize)
+                    {
+                        if (start == switchAt)
+                            switched.setEngine(PassiveEQ::Engine::Eco);
+                        if (start == switchBackAt)
+                            switched.setEngine(engine);
+
+                        juce::dsp::AudioBlock<double> block(switchedOut.getArrayOfWritePointers(), 2,
+                                                            static_cast<size_t>(start), blockSize);
+                        switched.processBlock(block);
+                    }
+
+                    const double errorDB = getRelativeErrorDB(steadyOut, switchedOut);
+                    logMessage("Engine " + juce::String(static_cast<int>(engine)) + " to eco and back: "
+                               + juce::String(errorDB, 1) + " dB");
+                    expectLessThan(errorDB, handoverToleranceDB, "Engine " + juce::String(static_cast<int>(engine)) + " handover");
+                }
+            }
+
+            beginTest("Switching the filters to eco mid-stream hands the state over");
+            {
+                constexpr double sampleRate = 192000.0;
+                constexpr int numSamples = 96000;
+                constexpr int switchAt = numSamples / 3;
+                constexpr int switchBackAt = 2 * numSamples / 3;
+
+                FilterSection steady, switched;
+                setUpFilters(steady, sampleRate, 25.0f, 12000.0f, false);
+                setUpFilters(switched, sampleRate, 25.0f, 12000.0f, false);
+
+                juce::AudioBuffer<double> steadyOut(2, numSamples), switchedOut(2, numSamples);
+                fillWithLowNoise(steadyOut, random);
+                switchedOut.makeCopyOf(steadyOut);
+
+                processFilters(steady, steadyOut, 0, numSamples, blockSize);
+                processFilters(switched, switchedOut, 0, switchAt, blockSize);
+                switched.setEcoPrecision(true);
+                processFilters(switched, switchedOut, switchAt, switchBackAt - switchAt, blockSize);
+                switched.setEcoPrecision(false);
+                processFilters(switched, switchedOut, switchBackAt, numSamples - switchBackAt, blockSize);
+
+                const double errorDB = getRelativeErrorDB(steadyOut, switchedOut);
+                logMessage("Filters to eco and back: " + juce::String(errorDB, 1) + " dB");
+                expectLessThan(errorDB, handoverToleranceDB, "Filter handover");
+            }
+        }
+    };
+
+    class EcoPrecisionBenchmarks : public juce::UnitTest
+    {
+    public:
+        EcoPrecisionBenchmarks() : juce::UnitTest("Eco precision", Tests::benchmarkCategory) {}
+
+        void runTest() override
+        {
+            beginTest("Eco engines against the 64-bit engines");
+
+            juce::Random random(Tests::randomSeed);
+            constexpr double sampleRate = 96000.0;
+            constexpr int blockSize = 64;
+            constexpr int numBlocks = 4096;
+            constexpr int runs = 7;
+
+            const auto settings = makeLowShelfEQ(40.0f, 6.0f);
+            juce::AudioBuffer<float> input(2, blockSize), work(2, blockSize);
+            Tests::fillWithNoise(input, random);
+
+            auto timeBlocks = [&] (auto&& process)
+            {
+                return Tests::timeBestOf(runs, [&]
+                {
+                    for (int block = 0; block < numBlocks; ++block)
+                    {
+                        work.makeCopyOf(input);
+                        process();
+                    }
+                }) / numBlocks;
+            };
+
+            for (auto engine : { PassiveEQ::Engine::Vectorised, PassiveEQ::Engine::Parallel })
+            {
+                PassiveEQ full, eco;
+                Tests::setUpEQ(full, engine, sampleRate, blockSize, settings, settings);
+                Tests::setUpEQ(eco, PassiveEQ::Engine::Eco, sampleRate, blockSize, settings, settings);
+                juce::dsp::AudioBlock<float> block(work);
+
+                const double fullNs = timeBlocks([&] { full.processBlock(block); });
+                const double ecoNs = timeBlocks([&] { eco.processBlock(block); });
+
+                logMessage("EQ, 4 bands, 64-sample block: engine " + juce::String(static_cast<int>(engine)) + " "
+                           + juce::String(fullNs, 0) + " ns, eco " + juce::String(ecoNs, 0) + " ns ("
+                           + juce::String(fullNs / ecoNs, 2) + "x)");
+            }
+
+            FilterSection full, eco;
+            setUpFilters(full, sampleRate, 30.0f, 16000.0f, false);
+            setUpFilters(eco, sampleRate, 30.0f, 16000.0f, true);
+            juce::dsp::AudioBlock<float> block(work);
+
+            const double fullNs = timeBlocks([&] { full.processBlock(block); });
+            const double ecoNs = timeBlocks([&] { eco.processBlock(block); });
+
+            logMessage("HPF + LPF, 64-sample block: 64-bit " + juce::String(fullNs, 0) + " ns, eco "
+                       + juce::String(ecoNs, 0) + " ns (" + juce::String(fullNs / ecoNs, 2) + "x)");
+        }
+    };
+
+    static EcoPrecisionTests ecoPrecisionTests;
+    static EcoPrecisionBenchmarks ecoPrecisionBenchmarks;
+}
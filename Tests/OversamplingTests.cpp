@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    OversamplingTests - Saved Oversampling Choices and Resampler Benchmarks
+  ==============================================================================
+*/
+
+#include "TestUtilities.h"
+#include "PluginProcessor.h"
+#include "PolyphaseOversampler.h"
+#include "HysteresisProcessor.h"
+
+namespace Aetheri
+{
+    namespace
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 512;
+
+        // Reported latency of a prepared processor; with the EQ minimum phase it is the resampler's
+        int getPreparedLatency(AetheriAudioProcessor& processor)
+        {
+            processor.prepareToPlay(sampleRate, blockSize);
+            return processor.getLatencySamples();
+        }
+
+        int getResamplerLatency(OversamplingFilter design, int stages)
+        {
+            PolyphaseOversampler<float> oversampler(design);
+            return oversampler.getLatencySamples(stages);
+        }
+
+        void setParameter(AetheriAudioProcessor& processor, int index, float plainValue)
+        {
+            auto* parameter = processor.getParameters().getParameter(ParamIDs::fromIndex(index));
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+        }
+    }
+
+    class OversamplingTests : public juce::UnitTest
+    {
+    public:
+        OversamplingTests() : juce::UnitTest("Oversampling", Tests::testCategory) {}
+
+        void runTest() override
+        {
+            beginTest("Saved 1x, 2x and 4x choices keep their factor");
+            {
+                // The original choice had three entries, so hosts stored 0, 0.5 and 1
+                for (int stages = 0; stages <= 2; ++stages)
+                {
+                    AetheriAudioProcessor processor;
+                    auto* choice = processor.getParameters().getParameter(ParamIDs::oversampling);
+                    choice->setValueNotifyingHost(static_cast<float>(stages) / 2.0f);
+
+                    expectEquals(getPreparedLatency(processor), getResamplerLatency(OversamplingFilter::MinimumLatencyIIR, stages),
+                                 juce::String(1 << stages) + "x from its normalised value");
+                }
+            }
+
+            beginTest("8x and 16x override the original choice");
+            {
+                for (int high = 1; high <= 2; ++high)
+                {
+                    AetheriAudioProcessor processor;
+                    auto& parameters = processor.getParameters();
+                    auto* choice = parameters.getParameter(ParamIDs::oversampling);
+                    auto* highChoice = parameters.getParameter(ParamIDs::highOversampling);
+                    choice->setValueNotifyingHost(choice->convertTo0to1(1.0f));
+                    highChoice->setValueNotifyingHost(highChoice->convertTo0to1(static_cast<float>(high)));
+
+                    expectEquals(getPreparedLatency(processor), getResamplerLatency(OversamplingFilter::MinimumLatencyIIR, high + 2),
+                                 juce::String(4 << high) + "x");
+
+                    // Off again, the original choice is still there
+                    highChoice->setValueNotifyingHost(0.0f);
+                    expectEquals(getPreparedLatency(processor), getResamplerLatency(OversamplingFilter::MinimumLatencyIIR, 1),
+                                 "Back to 2x");
+                }
+            }
+
+            beginTest("Auto rides a transient without a gap and switches up at the next silence");
+            {
+                AetheriAudioProcessor processor;
+                setParameter(processor, ParamIndex::hystEnabled, 1.0f);
+                setParameter(processor, ParamIndex::tubeHarmonics, 60.0f);
+                setParameter(processor, ParamIndex::transformerSat, 60.0f);
+                setParameter(processor, ParamIndex::oversamplingAuto, 1.0f);
+                processor.prepareToPlay(sampleRate, blockSize);
+
+                const auto& governor = processor.getOversamplingGovernor();
+                const int fullScaleFactor = governor.getFactor();
+                expectGreaterThan(fullScaleFactor, 1, "Drive needs oversampling at full scale");
+
+                juce::AudioBuffer<float> buffer(2, blockSize);
+                juce::MidiBuffer midi;
+                double phase = 0.0;
+
+                // Host blocks of a 1 kHz sine; returns the worst ratio of output to input peak
+                // over 64-sample windows
+                auto play = [&] (double seconds, float level)
+                {
+                    float worstRatio = 1.0f;
+
+                    for (int done = 0; done < static_cast<int>(seconds * sampleRate); done += blockSize)
+                    {
+                        for (int i = 0; i < blockSize; ++i)
+                        {
+                            const auto sample = static_cast<float>(level * std::sin(phase));
+                            buffer.setSample(0, i, sample);
+                            buffer.setSample(1, i, sample);
+                            phase += juce::MathConstants<double>::twoPi * 1000.0 / sampleRate;
+                        }
+
+                        processor.processBlock(buffer, midi);
+
+                        for (int start = 0; level > 0.0f && start < blockSize; start += 64)
+                            worstRatio = std::min(worstRatio, buffer.getMagnitude(0, start, 64) / level);
+                    }
+
+                    return worstRatio;
+                };
+
+                // A quiet passage held long enough lowers the factor
+                play(6.0, 0.01f);
+                const int quietFactor = governor.getFactor();
+                expectLessThan(quietFactor, fullScaleFactor, "Quiet passage lowers the factor");
+
+                // The transient is saturated at the lowered factor rather than faded out and in
+                const float worstRatio = play(0.5, 0.9f);
+                expectEquals(governor.getFactor(), quietFactor, "No switch on the transient");
+                expectGreaterThan(worstRatio, 0.25f, "No gap in the output");
+
+                // Back at full scale once the chain has decayed into silence
+                play(2.0, 0.0f);
+                expectEquals(governor.getFactor(), fullScaleFactor, "Full-scale factor after silence");
+            }
+        }
+    };
+
+    class OversamplingBenchmarks : public juce::UnitTest
+    {
+    public:
+        OversamplingBenchmarks() : juce::UnitTest("Oversampling", Tests::benchmarkCategory) {}
+
+        void runTest() override
+        {
+            beginTest("Polyphase resampler against juce::dsp::Oversampling, with the hysteresis stage");
+
+            juce::Random random(Tests::randomSeed);
+            constexpr int numBlocks = 256;
+            constexpr int runs = 5;
+
+            juce::AudioBuffer<float> input(2, blockSize), work(2, blockSize);
+            Tests::fillWithNoise(input, random);
+            juce::dsp::AudioBlock<float> block(work);
+
+            auto timeBlocks = [&] (auto&& process)
+            {
+                return Tests::timeBestOf(runs, [&]
+                {
+                    for (int i = 0; i < numBlocks; ++i)
+                    {
+                        work.makeCopyOf(input);
+                        process();
+                    }
+                }) / numBlocks;
+            };
+
+            for (auto design : { OversamplingFilter::MinimumLatencyIIR, OversamplingFilter::LinearPhaseFIR })
+            {
+                const bool fir = design == OversamplingFilter::LinearPhaseFIR;
+
+                for (int stages = 1; stages <= PolyphaseOversampler<float>::maxStages; ++stages)
+                {
+                    const int factor = 1 << stages;
+
+                    PolyphaseOversampler<float> polyphase(design);
+                    polyphase.setNumStages(stages);
+
+                    // The path it replaced: whole-block up, process, whole-block down
+                    using JuceOversampling = juce::dsp::Oversampling<float>;
+                    JuceOversampling juceOversampling(2, static_cast<size_t>(stages),
+                                                      fir ? JuceOversampling::filterHalfBandFIREquiripple
+                                                          : JuceOversampling::filterHalfBandPolyphaseIIR,
+                                                      true, true);
+                    juceOversampling.initProcessing(blockSize);
+
+                    HysteresisProcessor hysteresis;
+                    hysteresis.prepare(sampleRate, blockSize * factor);
+                    hysteresis.setOversampling(sampleRate, factor);
+                    hysteresis.setEnabled(true);
+                    hysteresis.setTubeHarmonics(50.0f);
+                    hysteresis.setTransformerSaturate(50.0f);
+
+                    const double polyphaseNs = timeBlocks([&]
+                    {
+                        polyphase.process(block, [&] (juce::dsp::AudioBlock<float> oversampled)
+                        {
+                            hysteresis.processBlock(oversampled);
+                        });
+                    });
+
+                    const double juceNs = timeBlocks([&]
+                    {
+                        auto oversampled = juceOversampling.processSamplesUp(block);
+                        hysteresis.processBlock(oversampled);
+                        juceOversampling.processSamplesDown(block);
+                    });
+
+                    logMessage(juce::String(factor) + "x " + (fir ? "FIR" : "IIR") + ", "
+                               + juce::String(blockSize) + "-sample block: polyphase " + juce::String(polyphaseNs / 1000.0, 1)
+                               + " us, latency " + juce::String(polyphase.getLatencySamples())
+                               + "; juce::dsp::Oversampling " + juce::String(juceNs / 1000.0, 1)
+                               + " us, latency " + juce::String(juceOversampling.getLatencyInSamples(), 1)
+                               + " (" + juce::String(juceNs / polyphaseNs, 2) + "x the polyphase time)");
+                }
+            }
+        }
+    };
+
+    static OversamplingTests oversamplingTests;
+    static OversamplingBenchmarks oversamplingBenchmarks;
+}
@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    ParallelBiquadKernelTests - Parallel Form Against the Serial Cascade
+  ==============================================================================
+*/
+
+#include "TestUtilities.h"
+#include "ParallelBiquadKernel.h"
+#include "StereoBiquadKernel.h"
+
+namespace Aetheri
+{
+    namespace
+    {
+        ParallelBiquadKernel::Cascade makeCascade(double sampleRate, const Tests::EQSettings& settings)
+        {
+            ParallelBiquadKernel::Cascade cascade;
+
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                cascade[static_cast<size_t>(band)] = BiquadCoefficientCache::design(Tests::makeBandKey(sampleRate, settings, band));
+
+            return cascade;
+        }
+    }
+
+    class ParallelBiquadKernelTests : public juce::UnitTest
+    {
+    public:
+        ParallelBiquadKernelTests() : juce::UnitTest("ParallelBiquadKernel", Tests::testCategory) {}
+
+        void runTest() override
+        {
+            juce::Random random(Tests::randomSeed);
+
+            beginTest("Parallel form has the cascade's magnitude and phase response");
+            {
+                // Well inside float resolution, which is what the kernel's output is rounded to
+                constexpr double magnitudeToleranceDB = 1.0e-6;
+                constexpr double phaseToleranceRadians = 1.0e-6;
+                constexpr int numFrequencies = 256;
+
+                double worstMagnitude = 0.0, worstPhase = 0.0;
+                int decomposed = 0, attempts = 0;
+
+                for (double sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+                {
+                    for (int trial = 0; trial < 64; ++trial)
+                    {
+                        const auto cascade = makeCascade(sampleRate, Tests::makeRandomEQ(random));
+                        ParallelBiquadKernel::ParallelForm form;
+                        ++attempts;
+
+                        if (!ParallelBiquadKernel::decompose(cascade, form))
+                            continue;
+
+                        ++decomposed;
+
+                        // Log-spaced from 10 Hz to just below Nyquist
+                        for (int i = 0; i < numFrequencies; ++i)
+                        {
+                            const double hz = 10.0 * std::pow(0.499 * sampleRate / 10.0, i / (numFrequencies - 1.0));
+                            const double omega = juce::MathConstants<double>::twoPi * hz / sampleRate;
+                            const auto serial = ParallelBiquadKernel::evaluate(cascade, omega);
+                            const auto parallel = ParallelBiquadKernel::evaluate(form, omega);
+
+                            worstMagnitude = std::max(worstMagnitude, std::abs(20.0 * std::log10(std::abs(parallel) / std::abs(serial))));
+                            worstPhase = std::max(worstPhase, std::abs(std::arg(parallel / serial)));
+                        }
+                    }
+                }
+
+                logMessage("Decomposed " + juce::String(decomposed) + " of " + juce::String(attempts)
+                           + " cascades; worst magnitude error " + juce::String(worstMagnitude, 12)
+                           + " dB, worst phase error " + juce::String(worstPhase, 12) + " rad");
+
+                // Settings the split rejects run on the serial fallback, so they only need to be rare
+                expectGreaterThan(decomposed, attempts * 9 / 10, "Most cascades decompose");
+                expectLessThan(worstMagnitude, magnitudeToleranceDB, "Magnitude response matches");
+                expectLessThan(worstPhase, phaseToleranceRadians, "Phase response matches");
+            }
+
+            beginTest("Parallel kernel output matches the serial kernel");
+            {
+                constexpr int numSamples = 8192;
+                constexpr double tolerance = 1.0e-9;
+                double worst = 0.0;
+
+                for (int trial = 0; trial < 32; ++trial)
+                {
+                    const double sampleRate = trial % 2 == 0 ? 48000.0 : 96000.0;
+                    const std::array<ParallelBiquadKernel::Cascade, 2> cascades {
+                        makeCascade(sampleRate, Tests::makeRandomEQ(random)),
+                        makeCascade(sampleRate, Tests::makeRandomEQ(random))
+                    };
+
+                    StereoBiquadKernel serial;
+                    ParallelBiquadKernel parallel;
+                    bool split = true;
+
+                    for (int lane = 0; lane < 2; ++lane)
+                    {
+                        for (int band = 0; band < ChannelEQ::NumBands; ++band)
+                            serial.setBandCoefficients(band, lane, cascades[static_cast<size_t>(lane)][static_cast<size_t>(band)]);
+
+                        split = parallel.setCascade(lane, cascades[static_cast<size_t>(lane)], 1) && split;
+                    }
+
+                    if (!split)
+                        continue;
+
+                    juce::AudioBuffer<double> serialOut(2, numSamples), parallelOut(2, numSamples);
+                    Tests::fillWithNoise(serialOut, random);
+                    parallelOut.makeCopyOf(serialOut);
+
+                    serial.processBlock(serialOut.getWritePointer(0), serialOut.getWritePointer(1), numSamples);
+                    parallel.processBlock(parallelOut.getWritePointer(0), parallelOut.getWritePointer(1), numSamples);
+
+                    worst = std::max(worst, Tests::maxAbsDifference(serialOut, parallelOut));
+                }
+
+                logMessage("Worst sample difference " + juce::String(worst, 15));
+                expectLessThan(worst, tolerance, "Parallel and serial kernels agree on noise");
+            }
+
+            beginTest("Parallel engine matches the serial engine through a parameter glide");
+            {
+                // While coefficients move, the two forms carry their state in different sections
+                // and so take slightly different paths; once settled they have to agree closely
+                constexpr double sampleRate = 48000.0;
+                constexpr int blockSize = 64;
+                constexpr int numSamples = 48000;
+                constexpr float glidingTolerance = 2.0e-2f;
+                constexpr float settledTolerance = 1.0e-5f;
+
+                const auto left = Tests::makeRandomEQ(random, 9.0f);
+                const auto right = Tests::makeRandomEQ(random, 9.0f);
+                auto movedLeft = Tests::makeRandomEQ(random, 9.0f);
+
+                // Frequency and gain glide; a curve change would jump in either engine
+                for (size_t band = 0; band < movedLeft.size(); ++band)
+                    movedLeft[band].curve = left[band].curve;
+
+                PassiveEQ serial, parallel;
+                Tests::setUpEQ(serial, PassiveEQ::Engine::Vectorised, sampleRate, blockSize, left, right);
+                Tests::setUpEQ(parallel, PassiveEQ::Engine::Parallel, sampleRate, blockSize, left, right);
+
+                juce::AudioBuffer<float> serialOut(2, numSamples), parallelOut(2, numSamples);
+                Tests::fillWithNoise(serialOut, random);
+                parallelOut.makeCopyOf(serialOut);
+
+                const int half = numSamples / 2;
+                juce::AudioBuffer<float> serialFirst(serialOut.getArrayOfWritePointers(), 2, half);
+                juce::AudioBuffer<float> parallelFirst(parallelOut.getArrayOfWritePointers(), 2, half);
+                Tests::processInBlocks(serial, serialFirst, blockSize);
+                Tests::processInBlocks(parallel, parallelFirst, blockSize);
+
+                // Left channel moves to new settings, gliding from here on
+                const auto moved = Tests::makeSnapshot(sampleRate, movedLeft, right);
+                serial.setCoefficientTargets(moved, false);
+                parallel.setCoefficientTargets(moved, false);
+
+                juce::AudioBuffer<float> serialSecond(serialOut.getArrayOfWritePointers(), 2, half, half);
+                juce::AudioBuffer<float> parallelSecond(parallelOut.getArrayOfWritePointers(), 2, half, half);
+                Tests::processInBlocks(serial, serialSecond, blockSize);
+                Tests::processInBlocks(parallel, parallelSecond, blockSize);
+
+                const float settledDifference = std::max(Tests::maxAbsDifference(serialFirst, parallelFirst),
+                                                         Tests::maxAbsDifference(serialSecond, parallelSecond, half / 2));
+                const float overallDifference = Tests::maxAbsDifference(serialOut, parallelOut);
+
+                logMessage("Worst difference settled " + juce::String(settledDifference, 9)
+                           + ", through the glide " + juce::String(overallDifference, 9));
+                expectLessThan(settledDifference, settledTolerance, "Settled output matches");
+                expectLessThan(overallDifference, glidingTolerance, "Gliding output stays close");
+            }
+        }
+    };
+
+    static ParallelBiquadKernelTests parallelBiquadKernelTests;
+}
@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    ProcessorAllocationTests - No Heap Allocation on the Audio Thread
+  ==============================================================================
+*/
+
+#include "TestUtilities.h"
+#include "PluginProcessor.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <vector>
+
+namespace Aetheri
+{
+    namespace Tests
+    {
+        // Heap allocations made by the counting thread while armed
+        std::atomic<int> allocationCount { 0 };
+        thread_local bool countAllocations = false;
+
+        inline void noteAllocation()
+        {
+            if (countAllocations)
+                allocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Counts whatever heap allocations the calling thread makes in its scope
+        struct ScopedAllocationCounter
+        {
+            ScopedAllocationCounter()   { allocationCount = 0; countAllocations = true; }
+            ~ScopedAllocationCounter()  { countAllocations = false; }
+
+            int getCount() const { return allocationCount.load(); }
+        };
+    }
+}
+
+// Replacements for the whole test program; the array and nothrow forms forward to these.
+// GCC takes free() after an inlined operator new for a mismatched pair
+JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wmismatched-new-delete")
+
+void* operator new(std::size_t size)
+{
+    Aetheri::Tests::noteAllocation();
+
+    if (auto* memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    Aetheri::Tests::noteAllocation();
+
+    // Over-allocate and keep the malloc'd address just below the aligned block
+    const auto align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+
+    if (auto* memory = std::malloc(size + align + sizeof(void*)))
+    {
+        const auto address = (reinterpret_cast<std::uintptr_t>(memory) + sizeof(void*) + align - 1) & ~(align - 1);
+        reinterpret_cast<void**>(address)[-1] = memory;
+        return reinterpret_cast<void*>(address);
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    if (memory != nullptr)
+        std::free(static_cast<void**>(memory)[-1]);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(memory, alignment);
+}
+
+JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+
+#if defined (__GLIBC__)
+// juce::HeapBlock (and so AudioBuffer) takes its memory from malloc rather than new
+extern "C"
+{
+    void* __libc_malloc(std::size_t);
+    void* __libc_calloc(std::size_t, std::size_t);
+    void* __libc_realloc(void*, std::size_t);
+
+    void* malloc(std::size_t size) noexcept
+    {
+        Aetheri::Tests::noteAllocation();
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t count, std::size_t size) noexcept
+    {
+        Aetheri::Tests::noteAllocation();
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* memory, std::size_t size) noexcept
+    {
+        Aetheri::Tests::noteAllocation();
+        return __libc_realloc(memory, size);
+    }
+}
+#endif
+
+namespace Aetheri
+{
+    namespace
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int preparedBlockSize = 512;
+        
+        // Long enough for the processor's message-thread timer to fire a few times
+        constexpr int messageLoopMs = 100;
+
+        void setParameter(AetheriAudioProcessor& processor, int index, float plainValue)
+        {
+            auto* parameter = processor.getParameters().getParameter(ParamIDs::fromIndex(index));
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+        }
+
+        // One change made on the message thread, then host blocks of every size through it
+        struct Step
+        {
+            const char* name;
+            std::function<void(AetheriAudioProcessor&)> change;
+        };
+
+        std::vector<Step> makeSteps()
+        {
+            using namespace ParamIndex;
+
+            return {
+                { "defaults",           [] (auto&) {} },
+                { "EQ bands",           [] (auto& p) { setParameter(p, bandGain(0, 0), 6.0f); setParameter(p, bandGain(2, 0), -4.0f);
+                                                       setParameter(p, bandCurve(3, 0), 1.0f); } },
+                { "HPF and LPF",        [] (auto& p) { setParameter(p, hpfEnabled, 1.0f); setParameter(p, hpfFreq, 80.0f);
+                                                       setParameter(p, lpfEnabled, 1.0f); setParameter(p, lpfFreq, 12000.0f); } },
+                { "hysteresis",         [] (auto& p) { setParameter(p, hystEnabled, 1.0f); setParameter(p, tubeHarmonics, 40.0f);
+                                                       setParameter(p, transformerSat, 30.0f); } },
+                { "4x oversampling",    [] (auto& p) { setParameter(p, oversampling, 2.0f); } },
+                { "FIR oversampling",   [] (auto& p) { setParameter(p, oversamplingFilter, 1.0f); } },
+                { "16x oversampling",   [] (auto& p) { setParameter(p, highOversampling, 2.0f); } },
+                { "Auto oversampling",  [] (auto& p) { setParameter(p, oversamplingAuto, 1.0f); } },
+                { "M/S unlinked",       [] (auto& p) { setParameter(p, stereoMode, 1.0f); setParameter(p, channelLink, 0.0f);
+                                                       setParameter(p, bandGain(1, 1), 3.0f); } },
+                { "parallel engine",    [] (auto& p) { setParameter(p, eqEngine, 1.0f); } },
+                { "reference engine",   [] (auto& p) { setParameter(p, eqEngine, 2.0f); } },
+                { "eco precision",      [] (auto& p) { setParameter(p, ecoPrecision, 1.0f); } },
+                { "linear phase",       [] (auto& p) { setParameter(p, linearPhase, 1.0f); } },
+                { "auto gain",          [] (auto& p) { setParameter(p, autoGainComp, 1.0f); } },
+                { "saturation off",     [] (auto& p) { setParameter(p, hystEnabled, 0.0f); setParameter(p, linearPhase, 0.0f); } },
+                { "bypass",             [] (auto& p) { setParameter(p, bypass, 1.0f); } },
+                { "back in",            [] (auto& p) { setParameter(p, bypass, 0.0f); setParameter(p, oversamplingAuto, 0.0f);
+                                                       setParameter(p, highOversampling, 0.0f); setParameter(p, oversampling, 1.0f); } },
+            };
+        }
+    }
+
+    class ProcessorAllocationTests : public juce::UnitTest
+    {
+    public:
+        ProcessorAllocationTests() : juce::UnitTest("Processor allocations", Tests::testCategory) {}
+
+        void runTest() override
+        {
+            for (bool offline : { false, true })
+            {
+                beginTest(juce::String("processBlock doesn't allocate, ") + (offline ? "offline render" : "realtime"));
+                runSteps<float>(offline);
+                runSteps<double>(offline);
+            }
+        }
+
+    private:
+        template <typename SampleType>
+        void runSteps(bool offline)
+        {
+            // Short, odd and longer-than-prepared host blocks, each run ending in silence so the
+            // chain goes to sleep and wakes again
+            constexpr int blockSizes[] = { preparedBlockSize, 64, 1, 17, 333, 4 * preparedBlockSize };
+            constexpr int samplesPerStep = 8192;
+
+            juce::Random random(Tests::randomSeed);
+            const bool doublePrecision = std::is_same<SampleType, double>::value;
+
+            AetheriAudioProcessor processor;
+            processor.setProcessingPrecision(doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                             : juce::AudioProcessor::singlePrecision);
+            processor.prepareToPlay(sampleRate, preparedBlockSize);
+
+            juce::AudioBuffer<SampleType> buffer(2, 4 * preparedBlockSize);
+            juce::MidiBuffer midi;
+
+            // Offline, the render profile takes over inside the counted blocks
+            processor.setNonRealtime(offline);
+
+            for (const auto& step : makeSteps())
+            {
+                // Whatever the last blocks asked of the message thread (filter designs, the
+                // reported latency) is delivered first, so each step starts with nothing pending
+                step.change(processor);
+                juce::MessageManager::getInstance()->runDispatchLoopUntil(messageLoopMs);
+                int allocations = 0;
+
+                for (int blockSize : blockSizes)
+                {
+                    for (int done = 0; done < samplesPerStep; done += blockSize)
+                    {
+                        buffer.setSize(2, blockSize, false, false, true);
+
+                        if (done < samplesPerStep * 3 / 4)
+                            Tests::fillWithNoise(buffer, random);
+                        else
+                            buffer.clear();
+
+                        Tests::ScopedAllocationCounter counter;
+                        processor.processBlock(buffer, midi);
+                        allocations += counter.getCount();
+                    }
+                }
+
+                expectEquals(allocations, 0, juce::String(step.name) + (doublePrecision ? ", 64-bit" : ", 32-bit"));
+            }
+        }
+    };
+
+    static ProcessorAllocationTests processorAllocationTests;
+}
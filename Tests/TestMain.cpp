@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    TestMain - Console Runner for the DSP Unit Tests and Benchmarks
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include "TestUtilities.h"
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    // Benchmarks time the machine rather than check behaviour, so they only run with --benchmarks
+    // (ctest lists them as disabled)
+    bool runBenchmarks = false;
+    
+    for (int i = 1; i < argc; ++i)
+        runBenchmarks = runBenchmarks || juce::String(argv[i]) == "--benchmarks";
+    
+    juce::Array<juce::UnitTest*> tests;
+    
+    for (auto* test : juce::UnitTest::getAllTests())
+        if ((test->getCategory() == Aetheri::Tests::benchmarkCategory) == runBenchmarks)
+            tests.add(test);
+    
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTests(tests, Aetheri::Tests::randomSeed);
+    
+    int failures = 0;
+    
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult(i)->failures;
+    
+    return failures == 0 ? 0 : 1;
+}
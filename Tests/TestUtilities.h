@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    TestUtilities - Shared Signals and EQ Set-Ups for the Unit Tests
+  ==============================================================================
+*/
+
+#pragma once
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <chrono>
+#include "PassiveEQ.h"
+
+namespace Aetheri
+{
+    namespace Tests
+    {
+        // Unit tests run under ctest by default; benchmarks only with --benchmarks
+        constexpr const char* testCategory = "Aetheri";
+        constexpr const char* benchmarkCategory = "Benchmarks";
+
+        // Fixed so a failure reproduces
+        constexpr juce::int64 randomSeed = 0x41657468;
+
+        struct BandSettings
+        {
+            EQBand::CurveType curve = EQBand::CurveType::Bell;
+            float frequency = 1000.0f;
+            float gainDB = 0.0f;
+        };
+
+        using EQSettings = std::array<BandSettings, ChannelEQ::NumBands>;
+
+        // Each band somewhere in its own range, as the controls allow
+        inline EQSettings makeRandomEQ(juce::Random& random, float maxGainDB = 12.0f)
+        {
+            EQSettings settings;
+
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+            {
+                auto& s = settings[static_cast<size_t>(band)];
+                const float minFreq = FreqRanges::getMinFreq(band);
+                const float maxFreq = FreqRanges::getMaxFreq(band);
+
+                s.curve = ParamIndex::hasCurve(band) && random.nextBool() ? EQBand::CurveType::Shelf
+                                                                          : EQBand::CurveType::Bell;
+                s.frequency = minFreq * std::pow(maxFreq / minFreq, random.nextFloat());
+                s.gainDB = (random.nextFloat() * 2.0f - 1.0f) * maxGainDB;
+            }
+
+            return settings;
+        }
+
+        inline BiquadCoefficientCache::Key makeBandKey(double sampleRate, const EQSettings& settings, int band)
+        {
+            const auto& s = settings[static_cast<size_t>(band)];
+            return EQBand::makeKey(sampleRate, s.curve, s.frequency, s.gainDB, BandDefaults::getQ(band));
+        }
+
+        // Band designs for both channels, as the processor's designer would make them
+        inline CoefficientSnapshot makeSnapshot(double sampleRate, const EQSettings& left, const EQSettings& right)
+        {
+            CoefficientTargets targets;
+            targets.sampleRate = sampleRate;
+
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+            {
+                targets.bands[0][static_cast<size_t>(band)] = makeBandKey(sampleRate, left, band);
+                targets.bands[1][static_cast<size_t>(band)] = makeBandKey(sampleRate, right, band);
+            }
+
+            static BiquadCoefficientCache cache;
+            static juce::uint32 generation = 0;
+            return CoefficientSnapshot::design(targets, cache, ++generation);
+        }
+
+        // Unlinked L/R EQ with every band enabled and designed, settled from the start
+        inline void setUpEQ(PassiveEQ& eq, PassiveEQ::Engine engine, double sampleRate, int blockSize,
+                            const EQSettings& left, const EQSettings& right)
+        {
+            eq.setChannelLink(false);
+            eq.prepare(sampleRate, blockSize);
+            eq.setEngine(engine);
+
+            for (int band = 0; band < ChannelEQ::NumBands; ++band)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    const auto& s = (ch == 0 ? left : right)[static_cast<size_t>(band)];
+                    eq.setBandParameters(band, ch, s.frequency, s.gainDB, 0.0f, s.curve, true);
+                }
+            }
+
+            eq.setCoefficientTargets(makeSnapshot(sampleRate, left, right), true);
+        }
+
+        template <typename SampleType>
+        void fillWithNoise(juce::AudioBuffer<SampleType>& buffer, juce::Random& random, SampleType level = SampleType(0.5))
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample(ch, i, level * static_cast<SampleType>(random.nextDouble() * 2.0 - 1.0));
+        }
+
+        // Runs the whole buffer through the EQ in host-sized blocks
+        template <typename SampleType>
+        void processInBlocks(PassiveEQ& eq, juce::AudioBuffer<SampleType>& buffer, int blockSize)
+        {
+            for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+            {
+                const int length = std::min(blockSize, buffer.getNumSamples() - start);
+                juce::dsp::AudioBlock<SampleType> block(buffer.getArrayOfWritePointers(), 2,
+                                                        static_cast<size_t>(start), static_cast<size_t>(length));
+                eq.processBlock(block);
+            }
+        }
+
+        template <typename SampleType>
+        SampleType maxAbsDifference(const juce::AudioBuffer<SampleType>& a, const juce::AudioBuffer<SampleType>& b,
+                                    int startSample = 0)
+        {
+            SampleType worst = 0;
+
+            for (int ch = 0; ch < a.getNumChannels(); ++ch)
+                for (int i = startSample; i < a.getNumSamples(); ++i)
+                    worst = std::max(worst, std::abs(a.getSample(ch, i) - b.getSample(ch, i)));
+
+            return worst;
+        }
+
+        // Best of several runs, in nanoseconds per call
+        template <typename Function>
+        double timeBestOf(int runs, Function&& function)
+        {
+            double best = 0.0;
+
+            for (int run = 0; run < runs; ++run)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                function();
+                const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                best = run == 0 ? elapsed : std::min(best, elapsed);
+            }
+
+            return best;
+        }
+    }
+}
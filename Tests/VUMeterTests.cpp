@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+    Aetheri - High-Fidelity Mastering EQ
+    VUMeterTests - Meter Ballistics Across Block Sizes
+  ==============================================================================
+*/
+
+#include "TestUtilities.h"
+#include "VUMeter.h"
+#include <vector>
+
+namespace Aetheri
+{
+    namespace
+    {
+        // Bursts with quieter gaps, so the peak is captured, held and decays again
+        juce::AudioBuffer<float> makeBursts(double sampleRate, double seconds, juce::Random& random)
+        {
+            juce::AudioBuffer<float> buffer(2, static_cast<int>(sampleRate * seconds));
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                {
+                    const double t = i / sampleRate;
+                    const float level = std::fmod(t, 3.7) < 0.4 ? 0.9f - 0.2f * static_cast<float>(std::floor(t / 3.7)) : 0.05f;
+                    buffer.setSample(ch, i, level * (random.nextFloat() * 2.0f - 1.0f));
+                }
+            }
+
+            return buffer;
+        }
+    }
+
+    class VUMeterTests : public juce::UnitTest
+    {
+    public:
+        VUMeterTests() : juce::UnitTest("VUMeter", Tests::testCategory) {}
+
+        void runTest() override
+        {
+            juce::Random random(Tests::randomSeed);
+
+            beginTest("Peak hold and decay don't depend on the block size");
+            {
+                constexpr double sampleRate = 48000.0;
+                constexpr int readInterval = 960;    // Where the editor might read it, every 20 ms
+                constexpr float toleranceDB = 1.0e-2f;  // Rounding of a per-sample float decay against one pow()
+
+                auto input = makeBursts(sampleRate, 12.0, random);
+                const int numSamples = input.getNumSamples();
+
+                // Sample by sample is the reference the block paths have to follow
+                auto readPeaks = [&] (int blockSize)
+                {
+                    StereoVUMeter meter;
+                    meter.prepare(sampleRate);
+                    std::vector<float> peaks;
+
+                    for (int start = 0; start < numSamples; start += blockSize)
+                    {
+                        const int length = std::min(blockSize, numSamples - start);
+                        juce::dsp::AudioBlock<float> block(input.getArrayOfWritePointers(), 2,
+                                                           static_cast<size_t>(start), static_cast<size_t>(length));
+                        meter.pushSamples(block);
+
+                        if ((start + length) % readInterval == 0)
+                            peaks.push_back(meter.getLeft().getPeakDB());
+                    }
+
+                    return peaks;
+                };
+
+                const auto expected = readPeaks(1);
+                float worst = 0.0f;
+
+                for (int blockSize : { 5, 64, 480, 960 })
+                {
+                    const auto peaks = readPeaks(blockSize);
+                    expectEquals(static_cast<int>(peaks.size()), static_cast<int>(expected.size()), "Readings");
+
+                    for (size_t i = 0; i < std::min(peaks.size(), expected.size()); ++i)
+                        worst = std::max(worst, std::abs(peaks[i] - expected[i]));
+                }
+
+                logMessage("Worst peak reading difference " + juce::String(worst, 6) + " dB");
+                expectLessThan(worst, toleranceDB, "Peak readings agree");
+            }
+
+            beginTest("Phase correlation covers every sub-block pushed since the last reading");
+            {
+                constexpr int hostBlockSize = 512;
+                constexpr int subBlockSize = 64;
+
+                // In phase, then out of phase in the last sub-block only
+                juce::AudioBuffer<double> buffer(2, hostBlockSize);
+                Tests::fillWithNoise(buffer, random);
+                buffer.copyFrom(1, 0, buffer, 0, 0, hostBlockSize);
+
+                for (int i = hostBlockSize - subBlockSize; i < hostBlockSize; ++i)
+                    buffer.setSample(1, i, -buffer.getSample(0, i));
+
+                StereoVUMeter whole, pieces;
+                whole.setCorrelationEnabled(true);
+                pieces.setCorrelationEnabled(true);
+                whole.prepare(48000.0);
+                pieces.prepare(48000.0);
+
+                juce::dsp::AudioBlock<double> block(buffer);
+                whole.pushSamples(block);
+                whole.updatePhaseCorrelation();
+
+                for (int start = 0; start < hostBlockSize; start += subBlockSize)
+                    pieces.pushSamples(block.getSubBlock(static_cast<size_t>(start), subBlockSize));
+
+                pieces.updatePhaseCorrelation();
+
+                // 7/8 of the block correlates and 1/8 anti-correlates: far from the last piece's -1
+                expectWithinAbsoluteError(pieces.getPhaseCorrelation(), whole.getPhaseCorrelation(), 1.0e-6f,
+                                          "Sub-blocks read as the whole block");
+                expectGreaterThan(pieces.getPhaseCorrelation(), 0.5f, "Reading is not the last sub-block's");
+
+                // Nothing pushed since: the reading stays
+                pieces.updatePhaseCorrelation();
+                expectWithinAbsoluteError(pieces.getPhaseCorrelation(), whole.getPhaseCorrelation(), 1.0e-6f,
+                                          "Reading held without new samples");
+            }
+        }
+    };
+
+    static VUMeterTests vuMeterTests;
+}